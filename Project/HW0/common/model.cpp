@@ -81,9 +81,24 @@ glm::mat4* Model::get_model()
 	return this->ModelTransform;
 }
 
+const std::vector<glm::vec3>& Model::get_vertices() const
+{
+	return this->vertices;
+}
+
+const std::vector<unsigned int>& Model::get_indices() const
+{
+	return this->indices;
+}
+
+DRAW_TYPE Model::get_type() const
+{
+	return this->type;
+}
+
 void Model::initialize(DRAW_TYPE type, const char * vertexShader_path, const char * fragmentShader_path)
 {
-	this->GLSLProgramID = LoadShaders(vertexShader_path, fragmentShader_path);
+	this->GLSLProgramID = AcquireShaders(vertexShader_path, fragmentShader_path);
 	this->type = type;
 	
 	glGenVertexArrays(1, &this->VertexArrayID);
@@ -196,7 +211,7 @@ void Model::initialize(DRAW_TYPE type, Model model){
 }
 void Model::initialize_picking(const char* picking_vertex_shader, const char* picking_fragment_shader)
 {
-	this->PickingProgramID = LoadShaders(picking_vertex_shader, picking_fragment_shader);
+	this->PickingProgramID = AcquireShaders(picking_vertex_shader, picking_fragment_shader);
 }
 
 bool Model::loadOBJ(const char * path,	glm::vec3 color){
@@ -594,6 +609,6 @@ void Model::cleanup()
 
 		
 	if (this->type == DRAW_TYPE::INDEX) glDeleteBuffers(1, &this->IndexBufferID);
-	glDeleteProgram(this->GLSLProgramID);
+	ReleaseShaders(this->GLSLProgramID);
 	glDeleteVertexArrays(1, &this->VertexArrayID);	
 }
\ No newline at end of file
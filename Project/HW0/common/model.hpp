@@ -52,6 +52,9 @@ public:
 	void set_projection(glm::mat4*);
 	void set_eye(glm::mat4*);
 	glm::mat4* get_model(void);
+	const std::vector<glm::vec3>& get_vertices(void) const;
+	const std::vector<unsigned int>& get_indices(void) const;
+	DRAW_TYPE get_type(void) const;
 	void set_model(glm::mat4*);
 	void initialize(DRAW_TYPE, const char *, const char *);
 	void initialize(DRAW_TYPE, GLuint);
@@ -59,7 +62,7 @@ public:
 	void initialize_picking(const char *, const char *);
 	void draw(void);
 	void draw2(Model );
-	void drawPicking(void);
+	void drawPicking(void);	// GPU color-ID picking. (See Picker for picking on the CPU instead.)
 	void cleanup(void);			
 };
 
@@ -0,0 +1,301 @@
+#include <vector>
+#include <algorithm>
+#include <limits>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "model.hpp"
+#include "picker.hpp"
+
+// Leaves hold at most this many triangles.
+static const int MAX_LEAF_TRIANGLES = 4;
+
+// Entry and exit t of the ray in the box. (inverse_direction: 1 / direction per axis)
+static bool intersect_box(const glm::vec3& min, const glm::vec3& max, const glm::vec3& origin, const glm::vec3& inverse_direction, float max_t, float& enter)
+{
+	glm::vec3 t0 = (min - origin) * inverse_direction;
+	glm::vec3 t1 = (max - origin) * inverse_direction;
+	glm::vec3 t_near = glm::min(t0, t1);
+	glm::vec3 t_far = glm::max(t0, t1);
+
+	enter = std::max(std::max(t_near.x, t_near.y), std::max(t_near.z, 0.0f));
+	float exit = std::min(std::min(t_far.x, t_far.y), std::min(t_far.z, max_t));
+
+	return enter <= exit;
+}
+
+// Moller-Trumbore. (Both sides of the triangle are hit.)
+static bool intersect_triangle(const glm::vec3* corner, const glm::vec3& origin, const glm::vec3& direction, float& t, float& u, float& v)
+{
+	glm::vec3 edge1 = corner[1] - corner[0];
+	glm::vec3 edge2 = corner[2] - corner[0];
+	glm::vec3 p = glm::cross(direction, edge2);
+	float determinant = glm::dot(edge1, p);
+
+	if (std::abs(determinant) < 1e-12f)
+		return false;
+
+	float inverse_determinant = 1.0f / determinant;
+	glm::vec3 s = origin - corner[0];
+
+	u = glm::dot(s, p) * inverse_determinant;
+	if (u < 0.0f || u > 1.0f)
+		return false;
+
+	glm::vec3 q = glm::cross(s, edge1);
+
+	v = glm::dot(direction, q) * inverse_determinant;
+	if (v < 0.0f || u + v > 1.0f)
+		return false;
+
+	t = glm::dot(edge2, q) * inverse_determinant;
+
+	return t >= 0.0f;
+}
+
+void TriangleBVH::build(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices)
+{
+	int count = (int)(indices.empty() ? vertices.size() : indices.size()) / 3;
+
+	nodes.clear();
+	corners.resize(count * 3);
+	triangles.resize(count);
+
+	if (count == 0)
+		return;
+
+	std::vector<glm::vec3> centers(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		for (int k = 0; k < 3; k++)
+			corners[i * 3 + k] = vertices[indices.empty() ? i * 3 + k : indices[i * 3 + k]];
+
+		triangles[i] = i;
+		centers[i] = (corners[i * 3] + corners[i * 3 + 1] + corners[i * 3 + 2]) / 3.0f;
+	}
+
+	// (At most 2 * count - 1 nodes, so the references below never move.)
+	nodes.reserve(count * 2);
+	nodes.push_back(Node());
+	build_node(0, 0, count, centers);
+}
+
+void TriangleBVH::build_node(int node, int first, int count, std::vector<glm::vec3>& centers)
+{
+	glm::vec3 min(std::numeric_limits<float>::max());
+	glm::vec3 max(-std::numeric_limits<float>::max());
+	glm::vec3 center_min = min;
+	glm::vec3 center_max = max;
+
+	for (int i = first; i < first + count; i++)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			min = glm::min(min, corners[i * 3 + k]);
+			max = glm::max(max, corners[i * 3 + k]);
+		}
+
+		center_min = glm::min(center_min, centers[i]);
+		center_max = glm::max(center_max, centers[i]);
+	}
+
+	nodes[node].min = min;
+	nodes[node].max = max;
+
+	glm::vec3 extent = center_max - center_min;
+	int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+
+	if (count <= MAX_LEAF_TRIANGLES || extent[axis] <= 0.0f)
+	{
+		nodes[node].first = first;
+		nodes[node].count = count;
+		return;
+	}
+
+	// Split at the median of the centers along the longest axis. (Move the corners and the indices along.)
+	std::vector<int> order(count);
+
+	for (int i = 0; i < count; i++)
+		order[i] = first + i;
+
+	int half = count / 2;
+
+	std::nth_element(order.begin(), order.begin() + half, order.end(), [&](int a, int b) {
+		return centers[a][axis] < centers[b][axis];
+	});
+
+	std::vector<glm::vec3> sorted_corners(count * 3);
+	std::vector<glm::vec3> sorted_centers(count);
+	std::vector<int> sorted_triangles(count);
+
+	for (int i = 0; i < count; i++)
+	{
+		for (int k = 0; k < 3; k++)
+			sorted_corners[i * 3 + k] = corners[order[i] * 3 + k];
+
+		sorted_centers[i] = centers[order[i]];
+		sorted_triangles[i] = triangles[order[i]];
+	}
+
+	std::copy(sorted_corners.begin(), sorted_corners.end(), corners.begin() + first * 3);
+	std::copy(sorted_centers.begin(), sorted_centers.end(), centers.begin() + first);
+	std::copy(sorted_triangles.begin(), sorted_triangles.end(), triangles.begin() + first);
+
+	int left = (int)nodes.size();
+
+	nodes.push_back(Node());
+	nodes.push_back(Node());
+	nodes[node].first = left;
+	nodes[node].count = 0;
+
+	build_node(left, first, half, centers);
+	build_node(left + 1, first + half, count - half, centers);
+}
+
+bool TriangleBVH::intersect(const glm::vec3& origin, const glm::vec3& direction, float max_t, float& t, int& triangle, glm::vec3& barycentric) const
+{
+	if (nodes.empty())
+		return false;
+
+	glm::vec3 inverse_direction = 1.0f / direction;
+	float enter;
+	bool is_hit = false;
+
+	int stack[64];
+	int stack_size = 0;
+
+	if (intersect_box(nodes[0].min, nodes[0].max, origin, inverse_direction, max_t, enter))
+		stack[stack_size++] = 0;
+
+	while (stack_size > 0)
+	{
+		const Node& node = nodes[stack[--stack_size]];
+
+		// The box may be farther than a hit found after it was pushed.
+		if (!intersect_box(node.min, node.max, origin, inverse_direction, max_t, enter))
+			continue;
+
+		if (node.count > 0)
+		{
+			for (int i = node.first; i < node.first + node.count; i++)
+			{
+				float hit_t, u, v;
+
+				if (intersect_triangle(&corners[i * 3], origin, direction, hit_t, u, v) && hit_t <= max_t)
+				{
+					max_t = hit_t;
+					triangle = triangles[i];
+					barycentric = glm::vec3(1.0f - u - v, u, v);
+					is_hit = true;
+				}
+			}
+			continue;
+		}
+
+		// Visit the nearer child first. (Pushed last)
+		float left_enter, right_enter;
+		bool is_left_hit = intersect_box(nodes[node.first].min, nodes[node.first].max, origin, inverse_direction, max_t, left_enter);
+		bool is_right_hit = intersect_box(nodes[node.first + 1].min, nodes[node.first + 1].max, origin, inverse_direction, max_t, right_enter);
+
+		// (Median splits keep the depth under 64 for any mesh that fits in memory.)
+		if (is_left_hit && is_right_hit)
+		{
+			bool is_left_nearer = left_enter <= right_enter;
+
+			stack[stack_size++] = is_left_nearer ? node.first + 1 : node.first;
+			stack[stack_size++] = is_left_nearer ? node.first : node.first + 1;
+		}
+		else if (is_left_hit)
+			stack[stack_size++] = node.first;
+		else if (is_right_hit)
+			stack[stack_size++] = node.first + 1;
+	}
+
+	t = max_t;
+
+	return is_hit;
+}
+
+bool TriangleBVH::empty() const
+{
+	return nodes.empty();
+}
+
+void Picker::add_model(Model* model, const Model* mesh)
+{
+	if (mesh == nullptr)
+		mesh = model;
+
+	Object object;
+
+	object.model = model;
+	object.bvh = (int)(std::find(bvh_models.begin(), bvh_models.end(), mesh) - bvh_models.begin());
+
+	if (object.bvh == (int)bvhs.size())
+	{
+		bvhs.push_back(TriangleBVH());
+		bvhs.back().build(
+			mesh->get_vertices(),
+			mesh->get_type() == DRAW_TYPE::INDEX ? mesh->get_indices() : std::vector<unsigned int>()
+		);
+		bvh_models.push_back(mesh);
+	}
+
+	objects.push_back(object);
+}
+
+void Picker::clear()
+{
+	objects.clear();
+	bvhs.clear();
+	bvh_models.clear();
+}
+
+PickResult Picker::pick(const glm::vec3& origin, const glm::vec3& direction) const
+{
+	PickResult result;
+	glm::vec3 world_direction = glm::normalize(direction);
+	float max_t = std::numeric_limits<float>::max();
+
+	for (const Object& object : objects)
+	{
+		if (object.model->objectID < 0 || bvhs[object.bvh].empty())
+			continue;
+
+		// Into the model space. The direction isn't normalized again, so t stays the world distance.
+		glm::mat4 inverse = glm::inverse(*object.model->get_model());
+		glm::vec3 local_origin = glm::vec3(inverse * glm::vec4(origin, 1.0f));
+		glm::vec3 local_direction = glm::vec3(inverse * glm::vec4(world_direction, 0.0f));
+
+		float t;
+		int triangle;
+		glm::vec3 barycentric;
+
+		if (bvhs[object.bvh].intersect(local_origin, local_direction, max_t, t, triangle, barycentric))
+		{
+			max_t = t;
+			result.objectID = object.model->objectID;
+			result.triangle = triangle;
+			result.barycentric = barycentric;
+			result.distance = t;
+		}
+	}
+
+	return result;
+}
+
+PickResult Picker::pick(double cursor_x, double cursor_y, int width, int height, const glm::mat4& projection, const glm::mat4& eye) const
+{
+	// Cursor to the near & far planes, then back into the world.
+	glm::vec4 viewport(0.0f, 0.0f, (float)width, (float)height);
+	glm::vec3 window_point((float)cursor_x, (float)(height - cursor_y), 0.0f);
+
+	glm::vec3 near_point = glm::unProject(window_point, eye, projection, viewport);
+	window_point.z = 1.0f;
+	glm::vec3 far_point = glm::unProject(window_point, eye, projection, viewport);
+
+	return pick(near_point, far_point - near_point);
+}
@@ -0,0 +1,69 @@
+#ifndef PICKER_HPP
+#define PICKER_HPP
+
+#include <vector>
+#include <glm/glm.hpp>
+
+class Model;
+
+// Result of a pick. (objectID == -1 if nothing was hit.)
+struct PickResult {
+	int objectID = -1;
+	int triangle = -1;
+	glm::vec3 barycentric = glm::vec3(0.0f);	// Weights of the 3 vertices of the triangle
+	float distance = 0.0f;						// Along the (normalized) ray, in world units
+};
+
+// Bounding volume hierarchy over the triangles of one mesh, in model space.
+// The triangles are copied, so the mesh can be cleaned up after building.
+class TriangleBVH {
+	struct Node {
+		glm::vec3 min;
+		glm::vec3 max;
+		int first;		// Inner node: Index of the left child (the right one follows it), leaf: First triangle
+		int count;		// 0 for the inner nodes
+	};
+
+	std::vector<Node> nodes;
+	std::vector<glm::vec3> corners;		// 3 per triangle, in the BVH order
+	std::vector<int> triangles;			// Original triangle index of each triangle
+
+	void build_node(int node, int first, int count, std::vector<glm::vec3>& centers);
+
+public:
+	// indices may be empty. (Then every 3 vertices make a triangle.)
+	void build(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices);
+
+	// Nearest hit with t in [0, max_t] along origin + t * direction. Returns false if there's none.
+	bool intersect(const glm::vec3& origin, const glm::vec3& direction, float max_t, float& t, int& triangle, glm::vec3& barycentric) const;
+
+	bool empty() const;
+};
+
+// CPU picking: Casts a ray through the triangle BVHs of the models, using their current model matrices.
+// A standalone alternative to Model::drawPicking, which is kept: It needs no extra render pass and no read back
+// from the GPU. (Nothing in the skeleton picks yet. Call pick() from the cursor handler to use it.)
+class Picker {
+	struct Object {
+		Model* model;
+		int bvh;	// Index in bvhs
+	};
+
+	std::vector<Object> objects;
+	std::vector<TriangleBVH> bvhs;
+	std::vector<const Model*> bvh_models;	// Model each BVH was built from
+
+public:
+	// Add a model with its objectID. (Call before Model::cleanup, which frees the vertices.)
+	// mesh: Model which holds the vertices, for the models initialized from another model. The BVH is shared.
+	void add_model(Model* model, const Model* mesh = nullptr);
+	void clear(void);
+
+	// Pick along a ray in world space.
+	PickResult pick(const glm::vec3& origin, const glm::vec3& direction) const;
+
+	// Pick under the cursor. (Window coordinates with the origin at the top left, as GLFW reports them.)
+	PickResult pick(double cursor_x, double cursor_y, int width, int height, const glm::mat4& projection, const glm::mat4& eye) const;
+};
+
+#endif
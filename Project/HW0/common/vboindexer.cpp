@@ -1,100 +1,325 @@
 #include <vector>
-#include <map>
+#include <thread>
+#include <algorithm>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h> // for memcpy
+#include <math.h>
 
 #include <glm/glm.hpp>
 
 #include "vboindexer.hpp"
 
-#include <string.h> // for memcmp
+// Marks an unused slot of the hash table.
+static const unsigned int EMPTY_SLOT = 0xFFFFFFFFu;
 
+// Below this many vertices per thread, splitting the work costs more than it saves.
+static const size_t MIN_VERTICES_PER_THREAD = 65536;
 
 // Returns true iif v1 can be considered equal to v2
-bool is_near(float v1, float v2){
-	return fabs( v1-v2 ) < 0.01f;
+static bool is_near(float v1, float v2, float epsilon){
+	return fabs( v1-v2 ) < epsilon;
 }
 
-// Searches through all already-exported vertices
-// for a similar one.
-// Similar = same position + same UVs + same normal
-bool getSimilarVertexIndex( 
-	glm::vec3 & in_vertex, 
-	glm::vec2 & in_uv, 
-	glm::vec3 & in_normal, 
-	std::vector<glm::vec3> & out_vertices,
-	std::vector<glm::vec2> & out_uvs,
-	std::vector<glm::vec3> & out_normals,
-	unsigned short & result
+// FNV-1a, one 32-bit word at a time, then a final mix so that the low bits (which pick the slot) are good.
+static uint64_t hash_words(const uint32_t * words, int count){
+	uint64_t hash = 14695981039346656037ULL;
+	for ( int i=0; i<count; i++ ){
+		hash ^= words[i];
+		hash *= 1099511628211ULL;
+	}
+	hash ^= hash >> 29;
+	hash *= 0xBF58476D1CE4E5B9ULL;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+// Hash of the exact bits of a vertex.
+static uint64_t hash_vertex(const glm::vec3 & vertex, const glm::vec2 & uv, const glm::vec3 & normal){
+	// Adding 0 turns -0 into +0, so that the values which compare equal also hash equal.
+	float values[8] = {
+		vertex.x + 0.0f, vertex.y + 0.0f, vertex.z + 0.0f,
+		uv.x + 0.0f, uv.y + 0.0f,
+		normal.x + 0.0f, normal.y + 0.0f, normal.z + 0.0f
+	};
+	uint32_t words[8];
+	memcpy(words, values, sizeof(words));
+	return hash_words(words, 8);
+}
+
+// Hash of a cell of the grid used for epsilon welding.
+static uint64_t hash_cell(int64_t x, int64_t y, int64_t z){
+	uint32_t words[6] = {
+		(uint32_t)x, (uint32_t)(x >> 32),
+		(uint32_t)y, (uint32_t)(y >> 32),
+		(uint32_t)z, (uint32_t)(z >> 32)
+	};
+	return hash_words(words, 6);
+}
+
+// The streams we are indexing. (tangents and bitangents are NULL if we don't need them.)
+struct VertexStreams{
+	const glm::vec3 * vertices;
+	const glm::vec2 * uvs;
+	const glm::vec3 * normals;
+	const glm::vec3 * tangents;
+	const glm::vec3 * bitangents;
+};
+
+// The unique vertices found so far, and an open-addressing hash table (linear probing) over them.
+//
+// Exact welding hashes all the components of a vertex.
+// Epsilon welding only hashes the position, snapped to a grid of 2*epsilon sized cells :
+// a vertex closer than epsilon on every axis is then in one of the (at most) 2x2x2 cells around it.
+class VertexTable{
+public:
+	VertexTable(float epsilon, bool has_tbn, size_t expected_count) : epsilon(epsilon), has_tbn(has_tbn){
+		size_t capacity = 16;
+		while ( capacity < expected_count*2 )
+			capacity *= 2;
+		slots.assign(capacity, EMPTY_SLOT);
+	}
+
+	// Returns the index of the vertex, adding it if no similar vertex is there yet.
+	unsigned int insert(
+		const glm::vec3 & vertex, const glm::vec2 & uv, const glm::vec3 & normal,
+		const glm::vec3 * tangent, const glm::vec3 * bitangent
+	){
+		uint64_t hash;
+		unsigned int index = epsilon > 0.0f ? find_near(vertex, uv, normal, hash) : find_exact(vertex, uv, normal, hash);
+
+		if ( index != EMPTY_SLOT ){ // A similar vertex is already in the VBO, use it instead !
+			if ( has_tbn ){
+				// Average the tangents and the bitangents
+				tangents[index] += *tangent;
+				bitangents[index] += *bitangent;
+			}
+			return index;
+		}
+
+		// If not, it needs to be added in the output data.
+		if ( (vertices.size()+1)*2 > slots.size() )
+			grow();
+
+		index = (unsigned int)vertices.size();
+		vertices.push_back(vertex);
+		uvs     .push_back(uv);
+		normals .push_back(normal);
+		hashes  .push_back(hash);
+		if ( has_tbn ){
+			tangents  .push_back(*tangent);
+			bitangents.push_back(*bitangent);
+		}
+		place(index);
+		return index;
+	}
+
+	std::vector<glm::vec3> vertices;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec3> tangents;
+	std::vector<glm::vec3> bitangents;
+
+private:
+	unsigned int find_exact(const glm::vec3 & vertex, const glm::vec2 & uv, const glm::vec3 & normal, uint64_t & hash){
+		hash = hash_vertex(vertex, uv, normal);
+		size_t mask = slots.size() - 1;
+		for ( size_t slot = hash & mask; slots[slot] != EMPTY_SLOT; slot = (slot+1) & mask ){
+			unsigned int i = slots[slot];
+			if ( hashes[i] == hash && vertices[i] == vertex && uvs[i] == uv && normals[i] == normal )
+				return i;
+		}
+		return EMPTY_SLOT;
+	}
+
+	unsigned int find_near(const glm::vec3 & vertex, const glm::vec2 & uv, const glm::vec3 & normal, uint64_t & hash){
+		float cell_size = 2.0f * epsilon;
+		int64_t low[3], high[3];
+		for ( int a=0; a<3; a++ ){
+			low[a]  = (int64_t)floor( (vertex[a] - epsilon) / cell_size );
+			high[a] = (int64_t)floor( (vertex[a] + epsilon) / cell_size );
+		}
+		hash = hash_cell(
+			(int64_t)floor( vertex.x / cell_size ),
+			(int64_t)floor( vertex.y / cell_size ),
+			(int64_t)floor( vertex.z / cell_size )
+		);
+
+		// Take the oldest match, like a linear search would.
+		unsigned int result = EMPTY_SLOT;
+		size_t mask = slots.size() - 1;
+		for ( int64_t x = low[0]; x <= high[0]; x++ )
+		for ( int64_t y = low[1]; y <= high[1]; y++ )
+		for ( int64_t z = low[2]; z <= high[2]; z++ ){
+			uint64_t cell_hash = hash_cell(x, y, z);
+			for ( size_t slot = cell_hash & mask; slots[slot] != EMPTY_SLOT; slot = (slot+1) & mask ){
+				unsigned int i = slots[slot];
+				if (
+					i < result && hashes[i] == cell_hash &&
+					is_near( vertex.x , vertices[i].x, epsilon ) &&
+					is_near( vertex.y , vertices[i].y, epsilon ) &&
+					is_near( vertex.z , vertices[i].z, epsilon ) &&
+					is_near( uv.x     , uvs     [i].x, epsilon ) &&
+					is_near( uv.y     , uvs     [i].y, epsilon ) &&
+					is_near( normal.x , normals [i].x, epsilon ) &&
+					is_near( normal.y , normals [i].y, epsilon ) &&
+					is_near( normal.z , normals [i].z, epsilon )
+				){
+					result = i;
+				}
+			}
+		}
+		return result;
+	}
+
+	void place(unsigned int index){
+		size_t mask = slots.size() - 1;
+		size_t slot = hashes[index] & mask;
+		while ( slots[slot] != EMPTY_SLOT )
+			slot = (slot+1) & mask;
+		slots[slot] = index;
+	}
+
+	// Keep the load factor under 0.5.
+	void grow(){
+		slots.assign(slots.size()*2, EMPTY_SLOT);
+		for ( unsigned int i=0; i<vertices.size(); i++ )
+			place(i);
+	}
+
+	float epsilon;
+	bool has_tbn;
+	std::vector<uint64_t> hashes; // One per unique vertex
+	std::vector<unsigned int> slots;
+};
+
+// Indexes the vertices [begin, end) into the table.
+static void index_range(const VertexStreams & in, size_t begin, size_t end, VertexTable & table, unsigned int * out_indices){
+	for ( size_t i=begin; i<end; i++ ){
+		out_indices[i] = table.insert(
+			in.vertices[i], in.uvs[i], in.normals[i],
+			in.tangents ? &in.tangents[i] : NULL,
+			in.bitangents ? &in.bitangents[i] : NULL
+		);
+	}
+}
+
+static void index_streams(
+	const VertexStreams & in, size_t count, float epsilon, unsigned int thread_count,
+	std::vector<unsigned int> & out_indices, VertexTable *& out_table
 ){
-	// Lame linear search
-	for ( unsigned int i=0; i<out_vertices.size(); i++ ){
-		if (
-			is_near( in_vertex.x , out_vertices[i].x ) &&
-			is_near( in_vertex.y , out_vertices[i].y ) &&
-			is_near( in_vertex.z , out_vertices[i].z ) &&
-			is_near( in_uv.x     , out_uvs     [i].x ) &&
-			is_near( in_uv.y     , out_uvs     [i].y ) &&
-			is_near( in_normal.x , out_normals [i].x ) &&
-			is_near( in_normal.y , out_normals [i].y ) &&
-			is_near( in_normal.z , out_normals [i].z )
-		){
-			result = i;
-			return true;
+	bool has_tbn = in.tangents != NULL;
+
+	if ( thread_count == 0 )
+		thread_count = std::max(1u, std::thread::hardware_concurrency());
+	size_t chunk_count = std::min<size_t>(thread_count, count / MIN_VERTICES_PER_THREAD);
+
+	out_indices.resize(count);
+
+	if ( chunk_count <= 1 ){
+		// Meshes are usually shared by about 6 triangles per vertex.
+		out_table = new VertexTable(epsilon, has_tbn, count / 4);
+		index_range(in, 0, count, *out_table, out_indices.data());
+		return;
+	}
+
+	// Partition : Each thread indexes its own chunk into its own table.
+	std::vector<VertexTable *> tables(chunk_count);
+	std::vector<size_t> offsets(chunk_count + 1);
+	std::vector<std::thread> threads;
+	for ( size_t c=0; c<=chunk_count; c++ )
+		offsets[c] = count * c / chunk_count;
+	for ( size_t c=0; c<chunk_count; c++ ){
+		tables[c] = new VertexTable(epsilon, has_tbn, (offsets[c+1] - offsets[c]) / 4);
+		threads.push_back(std::thread(index_range, std::cref(in), offsets[c], offsets[c+1], std::ref(*tables[c]), out_indices.data()));
+	}
+	for ( size_t c=0; c<chunk_count; c++ )
+		threads[c].join();
+
+	// Merge : Insert the unique vertices of every chunk into one table, in order.
+	// (With exact welding, this gives the same VBO as indexing on one thread.)
+	size_t unique_count = 0;
+	for ( size_t c=0; c<chunk_count; c++ )
+		unique_count += tables[c]->vertices.size();
+	out_table = new VertexTable(epsilon, has_tbn, unique_count);
+	for ( size_t c=0; c<chunk_count; c++ ){
+		VertexTable & chunk = *tables[c];
+		std::vector<unsigned int> remap(chunk.vertices.size());
+		for ( size_t i=0; i<chunk.vertices.size(); i++ ){
+			remap[i] = out_table->insert(
+				chunk.vertices[i], chunk.uvs[i], chunk.normals[i],
+				has_tbn ? &chunk.tangents[i] : NULL,
+				has_tbn ? &chunk.bitangents[i] : NULL
+			);
 		}
+		for ( size_t i=offsets[c]; i<offsets[c+1]; i++ )
+			out_indices[i] = remap[ out_indices[i] ];
+		delete tables[c];
 	}
-	// No other vertex could be used instead.
-	// Looks like we'll have to add it to the VBO.
-	return false;
 }
 
-void indexVBO_slow(
-	std::vector<glm::vec3> & in_vertices,
-	std::vector<glm::vec2> & in_uvs,
-	std::vector<glm::vec3> & in_normals,
+void indexVBO_hash(
+	const std::vector<glm::vec3> & in_vertices,
+	const std::vector<glm::vec2> & in_uvs,
+	const std::vector<glm::vec3> & in_normals,
 
-	std::vector<unsigned short> & out_indices,
+	std::vector<unsigned int> & out_indices,
 	std::vector<glm::vec3> & out_vertices,
 	std::vector<glm::vec2> & out_uvs,
-	std::vector<glm::vec3> & out_normals
+	std::vector<glm::vec3> & out_normals,
+
+	float epsilon,
+	unsigned int thread_count
 ){
-	// For each input vertex
-	for ( unsigned int i=0; i<in_vertices.size(); i++ ){
-
-		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
-		bool found = getSimilarVertexIndex(in_vertices[i], in_uvs[i], in_normals[i],     out_vertices, out_uvs, out_normals, index);
-
-		if ( found ){ // A similar vertex is already in the VBO, use it instead !
-			out_indices.push_back( index );
-		}else{ // If not, it needs to be added in the output data.
-			out_vertices.push_back( in_vertices[i]);
-			out_uvs     .push_back( in_uvs[i]);
-			out_normals .push_back( in_normals[i]);
-			out_indices .push_back( (unsigned short)out_vertices.size() - 1 );
-		}
-	}
+	VertexStreams in = {in_vertices.data(), in_uvs.data(), in_normals.data(), NULL, NULL};
+	VertexTable * table;
+
+	index_streams(in, in_vertices.size(), epsilon, thread_count, out_indices, table);
+
+	out_vertices.swap(table->vertices);
+	out_uvs     .swap(table->uvs);
+	out_normals .swap(table->normals);
+	delete table;
 }
 
-struct PackedVertex{
-	glm::vec3 position;
-	glm::vec2 uv;
-	glm::vec3 normal;
-	bool operator<(const PackedVertex that) const{
-		return memcmp((void*)this, (void*)&that, sizeof(PackedVertex))>0;
-	};
-};
+void indexVBO_TBN_hash(
+	const std::vector<glm::vec3> & in_vertices,
+	const std::vector<glm::vec2> & in_uvs,
+	const std::vector<glm::vec3> & in_normals,
+	const std::vector<glm::vec3> & in_tangents,
+	const std::vector<glm::vec3> & in_bitangents,
+
+	std::vector<unsigned int> & out_indices,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+	std::vector<glm::vec3> & out_tangents,
+	std::vector<glm::vec3> & out_bitangents,
 
-bool getSimilarVertexIndex_fast( 
-	PackedVertex & packed, 
-	std::map<PackedVertex,unsigned short> & VertexToOutIndex,
-	unsigned short & result
+	float epsilon,
+	unsigned int thread_count
 ){
-	std::map<PackedVertex,unsigned short>::iterator it = VertexToOutIndex.find(packed);
-	if ( it == VertexToOutIndex.end() ){
+	VertexStreams in = {in_vertices.data(), in_uvs.data(), in_normals.data(), in_tangents.data(), in_bitangents.data()};
+	VertexTable * table;
+
+	index_streams(in, in_vertices.size(), epsilon, thread_count, out_indices, table);
+
+	out_vertices  .swap(table->vertices);
+	out_uvs       .swap(table->uvs);
+	out_normals   .swap(table->normals);
+	out_tangents  .swap(table->tangents);
+	out_bitangents.swap(table->bitangents);
+	delete table;
+}
+
+// Narrows the indices for the 16-bit API. Returns false (and prints why) if they don't fit.
+static bool to_short_indices(const std::vector<unsigned int> & indices, size_t vertex_count, std::vector<unsigned short> & out_indices){
+	if ( vertex_count > 65536 ){
+		printf("indexVBO: %u unique vertices don't fit in 16-bit indices. Use indexVBO_hash instead.\n", (unsigned int)vertex_count);
 		return false;
-	}else{
-		result = it->second;
-		return true;
 	}
+	out_indices.assign(indices.begin(), indices.end());
+	return true;
 }
 
 void indexVBO(
@@ -107,37 +332,16 @@ void indexVBO(
 	std::vector<glm::vec2> & out_uvs,
 	std::vector<glm::vec3> & out_normals
 ){
-	std::map<PackedVertex,unsigned short> VertexToOutIndex;
-
-	// For each input vertex
-	for ( unsigned int i=0; i<in_vertices.size(); i++ ){
-
-		PackedVertex packed = {in_vertices[i], in_uvs[i], in_normals[i]};
-		
-
-		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
-		bool found = getSimilarVertexIndex_fast( packed, VertexToOutIndex, index);
-
-		if ( found ){ // A similar vertex is already in the VBO, use it instead !
-			out_indices.push_back( index );
-		}else{ // If not, it needs to be added in the output data.
-			out_vertices.push_back( in_vertices[i]);
-			out_uvs     .push_back( in_uvs[i]);
-			out_normals .push_back( in_normals[i]);
-			unsigned short newindex = (unsigned short)out_vertices.size() - 1;
-			out_indices .push_back( newindex );
-			VertexToOutIndex[ packed ] = newindex;
-		}
+	std::vector<unsigned int> indices;
+	indexVBO_hash(in_vertices, in_uvs, in_normals, indices, out_vertices, out_uvs, out_normals);
+
+	if ( !to_short_indices(indices, out_vertices.size(), out_indices) ){
+		out_vertices.clear();
+		out_uvs     .clear();
+		out_normals .clear();
 	}
 }
 
-
-
-
-
-
-
 void indexVBO_TBN(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
@@ -152,26 +356,19 @@ void indexVBO_TBN(
 	std::vector<glm::vec3> & out_tangents,
 	std::vector<glm::vec3> & out_bitangents
 ){
-	// For each input vertex
-	for ( unsigned int i=0; i<in_vertices.size(); i++ ){
-
-		// Try to find a similar vertex in out_XXXX
-		unsigned short index;
-		bool found = getSimilarVertexIndex(in_vertices[i], in_uvs[i], in_normals[i],     out_vertices, out_uvs, out_normals, index);
-
-		if ( found ){ // A similar vertex is already in the VBO, use it instead !
-			out_indices.push_back( index );
-
-			// Average the tangents and the bitangents
-			out_tangents[index] += in_tangents[i];
-			out_bitangents[index] += in_bitangents[i];
-		}else{ // If not, it needs to be added in the output data.
-			out_vertices.push_back( in_vertices[i]);
-			out_uvs     .push_back( in_uvs[i]);
-			out_normals .push_back( in_normals[i]);
-			out_tangents .push_back( in_tangents[i]);
-			out_bitangents .push_back( in_bitangents[i]);
-			out_indices .push_back( (unsigned short)out_vertices.size() - 1 );
-		}
+	// (Welds similar vertices, not only the identical ones.)
+	std::vector<unsigned int> indices;
+	indexVBO_TBN_hash(
+		in_vertices, in_uvs, in_normals, in_tangents, in_bitangents,
+		indices, out_vertices, out_uvs, out_normals, out_tangents, out_bitangents,
+		0.01f
+	);
+
+	if ( !to_short_indices(indices, out_vertices.size(), out_indices) ){
+		out_vertices  .clear();
+		out_uvs       .clear();
+		out_normals   .clear();
+		out_tangents  .clear();
+		out_bitangents.clear();
 	}
 }
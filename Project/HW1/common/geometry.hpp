@@ -86,7 +86,8 @@ protected:
     std::vector<glm::vec3> colorList;
 
     // Members for communicating with the shaders.
-    GLuint programId;
+    // (programId is shared by the objects with the same shaders. See AcquireShaders().)
+    GLuint programId = 0;
     GLuint vertexArrayId;
     GLuint positionBufferId;
     GLuint normalBufferId;
@@ -94,6 +95,12 @@ protected:
     GLuint positionBufferIndex = 0;
     GLuint normalBufferIndex = 1;
     GLuint colorBufferIndex = 2;
+
+    // Uniform locations. (Looked up once in create(), not on every draw.)
+    GLint lightLocation = -1;
+    GLint projectionLocation = -1;
+    GLint eyeLocation = -1;
+    GLint modelTransformLocation = -1;
 public:
     // Destructor: Clean the members before the model is deleted.
     ~Object();
@@ -113,8 +120,8 @@ private:
     // Helper functions for create() and draw()
     void createArrayBuffer(std::vector<glm::vec3>& data, GLuint& id);
     void bindArrayBuffer(GLuint& id, GLuint& index);
-    void sendVec3ToShaders(glm::vec3& v, const char* name);
-    void sendMat4ToShaders(glm::mat4& m, const char* name);
+    void sendVec3ToShaders(glm::vec3& v, GLint location);
+    void sendMat4ToShaders(glm::mat4& m, GLint location);
 };
 
 // Connecting line between two nodes.
@@ -345,7 +352,7 @@ Object::~Object() {
     glDeleteBuffers(1, &normalBufferId);
     glDeleteBuffers(1, &colorBufferId);
 
-    glDeleteProgram(programId);
+    ReleaseShaders(programId);
     glDeleteVertexArrays(1, &vertexArrayId);
 }
 
@@ -374,7 +381,12 @@ Object& Object::setFill(bool fill) {
 }
 
 void Object::create(std::string vertexShaderPath, std::string fragmentShaderPath) {
-    programId = LoadShaders(vertexShaderPath.c_str(), fragmentShaderPath.c_str());
+    programId = AcquireShaders(vertexShaderPath.c_str(), fragmentShaderPath.c_str());
+
+    lightLocation = glGetUniformLocation(programId, "uLight");
+    projectionLocation = glGetUniformLocation(programId, "Projection");
+    eyeLocation = glGetUniformLocation(programId, "Eye");
+    modelTransformLocation = glGetUniformLocation(programId, "ModelTransform");
 
     glGenVertexArrays(1, &vertexArrayId);
     glBindVertexArray(vertexArrayId);
@@ -387,10 +399,10 @@ void Object::create(std::string vertexShaderPath, std::string fragmentShaderPath
 void Object::draw(glm::mat4& projectionMatrix, glm::mat4& eyeMatrix, glm::vec3& lightDirection) {
     glUseProgram(programId);
 
-    sendVec3ToShaders(lightDirection, "uLight");
-    sendMat4ToShaders(projectionMatrix, "Projection");
-    sendMat4ToShaders(eyeMatrix, "Eye");
-    sendMat4ToShaders(modelMatrix, "ModelTransform");
+    sendVec3ToShaders(lightDirection, lightLocation);
+    sendMat4ToShaders(projectionMatrix, projectionLocation);
+    sendMat4ToShaders(eyeMatrix, eyeLocation);
+    sendMat4ToShaders(modelMatrix, modelTransformLocation);
 
     glBindVertexArray(vertexArrayId);
 
@@ -428,19 +440,19 @@ void Object::bindArrayBuffer(GLuint& id, GLuint& index) {
     );
 }
 
-void Object::sendVec3ToShaders(glm::vec3& v, const char* name) {
+void Object::sendVec3ToShaders(glm::vec3& v, GLint location) {
     glUniform3f(
-        glGetUniformLocation(programId, name), // location
-        v.x, v.y, v.z                          // v0, v1, v2
+        location,     // location
+        v.x, v.y, v.z // v0, v1, v2
     );
 }
 
-void Object::sendMat4ToShaders(glm::mat4& m, const char* name) {
+void Object::sendMat4ToShaders(glm::mat4& m, GLint location) {
     glUniformMatrix4fv(
-        glGetUniformLocation(programId, name), // location
-        1,                                     // count
-        GL_FALSE,                              // transpose
-        &(m[0][0])                             // value
+        location,   // location
+        1,          // count
+        GL_FALSE,   // transpose
+        &(m[0][0])  // value
     );
 }
 // ==================================================================
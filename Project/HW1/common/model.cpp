@@ -61,7 +61,7 @@ void Model::SetDirectionalLight(vec3 a_dir_light) {
 }
 
 void Model::InitializeGLSL(DRAW_TYPE a_draw_type, const char * a_vertex_shader_path, const char * a_fragment_shader_path) {
-    m_glsl_program_id = LoadShaders(a_vertex_shader_path, a_fragment_shader_path);
+    m_glsl_program_id = AcquireShaders(a_vertex_shader_path, a_fragment_shader_path);
     m_draw_type = a_draw_type;
 
     glGenVertexArrays(1, &m_vertex_array_id);
@@ -141,6 +141,6 @@ void Model::CleanUp() {
     glDeleteBuffers(1, &m_normal_buffer_id);
     glDeleteBuffers(1, &m_color_buffer_id);
     if (m_draw_type == DRAW_TYPE::INDEX) glDeleteBuffers(1, &m_index_buffer_id);
-    glDeleteProgram(m_glsl_program_id);
+    ReleaseShaders(m_glsl_program_id);
     glDeleteVertexArrays(1, &m_vertex_array_id);
 }
@@ -3,7 +3,9 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include <algorithm>
+#include <map>
 using namespace std;
 
 #include <stdlib.h>
@@ -13,7 +15,39 @@ using namespace std;
 
 #include "shader.hpp"
 
-GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_path) {
+// Program of AcquireShaders(), and the number of its users.
+struct SharedProgram {
+    GLuint ID;
+    int UserCount;
+};
+
+// Keyed by the shader paths and the defines.
+static std::map<std::string, SharedProgram> SharedPrograms;
+
+// Put the defines after the #version line. (It must come first.)
+static void InsertDefines(std::string & code, const std::string & defines) {
+    if (defines.empty()) {
+        return;
+    }
+
+    size_t position = code.find("#version");
+
+    if (position == std::string::npos) {
+        code.insert(0, defines + "\n");
+        return;
+    }
+
+    position = code.find('\n', position);
+
+    if (position == std::string::npos) {
+        code += "\n" + defines + "\n";
+        return;
+    }
+
+    code.insert(position + 1, defines + "\n");
+}
+
+GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_path, const char * defines) {
 
     // Create the shaders
     GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
@@ -23,9 +57,8 @@ GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_pat
     std::string VertexShaderCode;
     std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
     if (VertexShaderStream.is_open()) {
-        std::string Line = "";
-        while (getline(VertexShaderStream, Line))
-            VertexShaderCode += "\n" + Line;
+        // (Read it at once, not line by line.)
+        VertexShaderCode.assign(std::istreambuf_iterator<char>(VertexShaderStream), std::istreambuf_iterator<char>());
         VertexShaderStream.close();
     }
     else {
@@ -38,14 +71,17 @@ GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_pat
     std::string FragmentShaderCode;
     std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
     if (FragmentShaderStream.is_open()) {
-        std::string Line = "";
-        while (getline(FragmentShaderStream, Line))
-            FragmentShaderCode += "\n" + Line;
+        FragmentShaderCode.assign(std::istreambuf_iterator<char>(FragmentShaderStream), std::istreambuf_iterator<char>());
         FragmentShaderStream.close();
     }
 
 
 
+    InsertDefines(VertexShaderCode, defines);
+    InsertDefines(FragmentShaderCode, defines);
+
+
+
     GLint Result = GL_FALSE;
     int InfoLogLength;
 
@@ -57,6 +93,13 @@ GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_pat
     glShaderSource(VertexShaderID, 1, &VertexSourcePointer, NULL);
     glCompileShader(VertexShaderID);
 
+    // Compile Fragment Shader
+    printf("Compiling shader : %s\n", fragment_file_path);
+    char const * FragmentSourcePointer = FragmentShaderCode.c_str();
+    glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer, NULL);
+    glCompileShader(FragmentShaderID);
+
+    // (Both compiles are issued before any status is queried, so the driver can run them in parallel.)
     // Check Vertex Shader
     glGetShaderiv(VertexShaderID, GL_COMPILE_STATUS, &Result);
     glGetShaderiv(VertexShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
@@ -66,14 +109,6 @@ GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_pat
         printf("%s\n", &VertexShaderErrorMessage[0]);
     }
 
-
-
-    // Compile Fragment Shader
-    printf("Compiling shader : %s\n", fragment_file_path);
-    char const * FragmentSourcePointer = FragmentShaderCode.c_str();
-    glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer, NULL);
-    glCompileShader(FragmentShaderID);
-
     // Check Fragment Shader
     glGetShaderiv(FragmentShaderID, GL_COMPILE_STATUS, &Result);
     glGetShaderiv(FragmentShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
@@ -107,4 +142,37 @@ GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_pat
     return ProgramID;
 }
 
+GLuint AcquireShaders(const char * vertex_file_path, const char * fragment_file_path, const char * defines) {
+    std::string Key = std::string(vertex_file_path) + "\n" + fragment_file_path + "\n" + defines;
+    auto Found = SharedPrograms.find(Key);
+
+    if (Found != SharedPrograms.end()) {
+        Found->second.UserCount++;
+        return Found->second.ID;
+    }
+
+    GLuint ProgramID = LoadShaders(vertex_file_path, fragment_file_path, defines);
+
+    // (A missing file gives 0. Don't share it, so the next call tries again.)
+    if (ProgramID != 0) {
+        SharedPrograms[Key] = { ProgramID, 1 };
+    }
+
+    return ProgramID;
+}
+
+void ReleaseShaders(GLuint program_id) {
+    // (There are only a few unique programs, so a linear search is fine.)
+    for (auto it = SharedPrograms.begin(); it != SharedPrograms.end(); it++) {
+        if (it->second.ID == program_id) {
+            if (--it->second.UserCount == 0) {
+                glDeleteProgram(program_id);
+                SharedPrograms.erase(it);
+            }
+
+            return;
+        }
+    }
 
+    glDeleteProgram(program_id);
+}
@@ -1,6 +1,16 @@
 #ifndef SHADER_HPP
 #define SHADER_HPP
 
-GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_path);
+#include <GL/glew.h>
+
+// Compile & link the shaders into a new program. (defines: "#define ..." lines, put after the #version line.)
+GLuint LoadShaders(const char * vertex_file_path, const char * fragment_file_path, const char * defines = "");
+
+// Same, but the program is shared: Each unique (vertex shader, fragment shader, defines) is compiled & linked once,
+// and every later call returns the same program. Release it with ReleaseShaders(), not glDeleteProgram().
+GLuint AcquireShaders(const char * vertex_file_path, const char * fragment_file_path, const char * defines = "");
+
+// Drop a program of AcquireShaders(). It's deleted with its last user. (Other programs are deleted right away.)
+void ReleaseShaders(GLuint program_id);
 
 #endif
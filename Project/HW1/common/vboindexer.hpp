@@ -1,6 +1,45 @@
 #ifndef VBOINDEXER_HPP
 #define VBOINDEXER_HPP
 
+// Hash-based indexer with 32-bit indices.
+// - epsilon == 0 : Only welds vertices which are exactly the same.
+// - epsilon > 0  : Welds vertices whose components are all closer than epsilon.
+// - thread_count : Number of threads for big inputs (0 = one per core). The input is split into
+//                  chunks which are indexed in parallel, then merged into one VBO.
+void indexVBO_hash(
+	const std::vector<glm::vec3> & in_vertices,
+	const std::vector<glm::vec2> & in_uvs,
+	const std::vector<glm::vec3> & in_normals,
+
+	std::vector<unsigned int> & out_indices,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+
+	float epsilon = 0.0f,
+	unsigned int thread_count = 1
+);
+
+// Same as indexVBO_hash, but also sums the tangents and the bitangents of the welded vertices.
+void indexVBO_TBN_hash(
+	const std::vector<glm::vec3> & in_vertices,
+	const std::vector<glm::vec2> & in_uvs,
+	const std::vector<glm::vec3> & in_normals,
+	const std::vector<glm::vec3> & in_tangents,
+	const std::vector<glm::vec3> & in_bitangents,
+
+	std::vector<unsigned int> & out_indices,
+	std::vector<glm::vec3> & out_vertices,
+	std::vector<glm::vec2> & out_uvs,
+	std::vector<glm::vec3> & out_normals,
+	std::vector<glm::vec3> & out_tangents,
+	std::vector<glm::vec3> & out_bitangents,
+
+	float epsilon = 0.0f,
+	unsigned int thread_count = 1
+);
+
+// 16-bit versions. (Fail if there are more than 65536 unique vertices.)
 void indexVBO(
 	std::vector<glm::vec3> & in_vertices,
 	std::vector<glm::vec2> & in_uvs,
@@ -28,4 +67,4 @@ void indexVBO_TBN(
 	std::vector<glm::vec3> & out_bitangents
 );
 
-#endif
\ No newline at end of file
+#endif
@@ -8,17 +8,21 @@ uniform struct Material {
 	float shininess;
 } u_material;
 
-// See Engine/Light.hpp.
-uniform struct Light {
-	int type;
+// See Engine/Light.hpp. (std140 layout: See Engine/LightBuffer.hpp.)
+struct Light {
 	vec3 position;
+	int type;
 	vec3 direction;
+	float angle;
 	vec3 ambient;
+	float attenuation;
 	vec3 diffuse;
 	vec3 specular;
-	float angle;
-	float attenuation;
-} u_lightList[5];
+};
+
+layout(std140) uniform LightBlock {
+	Light u_lightList[5];
+};
 
 uniform sampler2D u_textureUnit;
 uniform sampler2D u_normalMapUnit;
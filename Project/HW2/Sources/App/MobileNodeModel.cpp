@@ -12,13 +12,9 @@ namespace App {
 
     void MobileNodeModel::draw() {
         // Apply the transformations.
-        m_rotationAngle += m_rotationSpeed;
+        auto rotationAngle = glm::mix(m_lastRotationAngle, m_rotationAngle, m_interpolation);
 
-        if (m_rotationAngle > 360.0f) {
-            m_rotationAngle -= 360.0f;
-        }
-
-        m_modelMatrix = glm::translate(m_translation) * glm::rotate(m_rotationAngle, glm::vec3(0.0f, 1.0f, 0.0f));
+        m_modelMatrix = glm::translate(m_translation) * glm::rotate(rotationAngle, glm::vec3(0.0f, 1.0f, 0.0f));
 
         // Apply the parent node's transformation.
         if (m_parent != nullptr) {
@@ -43,6 +39,35 @@ namespace App {
         }
     }
 
+    void MobileNodeModel::update(float dt) {
+        m_lastRotationAngle = m_rotationAngle;
+        m_rotationAngle += m_rotationSpeed * dt;
+
+        // Keep the angle in a turn. (Move the last one along, so the drawn angle doesn't jump back.)
+        auto turn = glm::two_pi<float>();
+
+        if (m_rotationAngle > turn) {
+            m_rotationAngle -= turn;
+            m_lastRotationAngle -= turn;
+        }
+        else if (m_rotationAngle < -turn) {
+            m_rotationAngle += turn;
+            m_lastRotationAngle += turn;
+        }
+
+        for (auto& child : m_childList) {
+            child->update(dt);
+        }
+    }
+
+    void MobileNodeModel::setInterpolation(float alpha) {
+        m_interpolation = alpha;
+
+        for (auto& child : m_childList) {
+            child->setInterpolation(alpha);
+        }
+    }
+
     void MobileNodeModel::addShape(Shape shape) {
         glm::mat4 matrix = shape.getMatrix();
         glm::mat4 inverseMatrix = glm::inverse(matrix);
@@ -113,15 +138,6 @@ namespace App {
         }
     }
 
-    void MobileNodeModel::setLight(int index, const Engine::Light& light) {
-        Engine::Model::setLight(index, light);
-        m_wire.setLight(index, light);
-
-        for (auto& child : m_childList) {
-            child->setLight(index, light);
-        }
-    }
-
     void MobileNodeModel::setMaterial(const Engine::Material& material) {
         Engine::Model::setMaterial(material);
         m_wire.setMaterial(material);
@@ -11,6 +11,11 @@ namespace App {
 
         void draw() override;
 
+        // Advance the rotation by dt seconds. (The child nodes, too.)
+        void update(float dt);
+        // Draw the nodes this far between their last two updates. (See Engine::Window::getInterpolation().)
+        void setInterpolation(float alpha);
+
         // Add a shape(primitive).
         void addShape(Shape shape);
 
@@ -19,7 +24,7 @@ namespace App {
 
         // Reset the rotation speed.
         void resetRotationSpeed();
-        // Increment the rotation speed.
+        // Increment the rotation speed. (Radians per second)
         void addRotationSpeed(float value);
 
         // Set the translation.
@@ -32,7 +37,6 @@ namespace App {
         // Let the setters to apply the change to the child nodes, too.
         void setViewMatrix(const glm::mat4& matrix) override;
         void setProjectionMatrix(const glm::mat4& matrix) override;
-        void setLight(int index, const Engine::Light& light) override;
         void setMaterial(const Engine::Material& material) override;
         void setTexture(const Engine::Texture& texture) override;
         void setNormalMap(const Engine::Texture& normalMap) override;
@@ -51,8 +55,12 @@ namespace App {
         glm::vec3 m_translation;
         // Rotation angle w.r.t the parent node.
         float m_rotationAngle = 0.0f;
+        // Rotation angle before the last update.
+        float m_lastRotationAngle = 0.0f;
         // Rotation speed w.r.t the parent node.
         float m_rotationSpeed = 0.0f;
+        // Where to draw between the last two updates.
+        float m_interpolation = 1.0f;
 
         // Top position: Connected to parent node's bottom position.
         glm::vec3 m_topPosition;
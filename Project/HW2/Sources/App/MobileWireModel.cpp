@@ -19,6 +19,6 @@ namespace App {
         m_positionList[1] = endPosition;
 
         // Reset the VBO to apply the change.
-        setAttribute(0, m_positionList);
+        updateVertices();
     }
 }
@@ -28,7 +28,6 @@ namespace App {
                 normal[axis.z] = 1.0f;
 
                 m_positionList.emplace_back(position);
-                m_colorList.emplace_back(1.0f, 1.0f, 1.0f);
                 m_normalList.emplace_back(normal);
                 m_uvList.emplace_back(xy.x, xy.y);
             }
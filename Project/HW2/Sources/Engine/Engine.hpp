@@ -6,12 +6,19 @@
 // -- Standard headers.
 #include <iostream>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 #include <memory>
 #include <string>
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cctype>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
 
 // -- GLEW
 #include <GL/glew.h>
@@ -25,12 +32,16 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 // -- Engine
+#include "MappedFile.hpp"
+#include "GLState.hpp"
 #include "Window.hpp"
 #include "Light.hpp"
+#include "LightBuffer.hpp"
 #include "Material.hpp"
 #include "Shader.hpp"
 #include "Texture.hpp"
 #include "FBO.hpp"
+#include "VertexLayout.hpp"
 #include "Model.hpp"
 
 #endif
@@ -12,12 +12,11 @@ namespace Engine {
 
         // Create a frame buffer.
         glGenFramebuffers(1, &m_frameBufferId);
-        glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferId);
+        GLState::bindFramebuffer(m_frameBufferId);
 
         // Create an empty texture to render.
         glGenTextures(1, &m_textureId);
-        glActiveTexture(GL_TEXTURE0 + m_textureUnit);
-        glBindTexture(GL_TEXTURE_2D, m_textureId);
+        GLState::bindTexture(m_textureUnit, GL_TEXTURE_2D, m_textureId);
 
         glTexImage2D(
             GL_TEXTURE_2D,
@@ -55,17 +54,17 @@ namespace Engine {
             return;
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::bindFramebuffer(0);
     }
 
     void FBO::bind() const {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferId);
-        glViewport(0, 0, m_width, m_height);
+        GLState::bindFramebuffer(m_frameBufferId);
+        GLState::setViewport(0, 0, m_width, m_height);
     }
 
     void FBO::unbind() const {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, m_width, m_height);
+        GLState::bindFramebuffer(0);
+        GLState::setViewport(0, 0, m_width, m_height);
     }
 
     void FBO::setSize(int width, int height) {
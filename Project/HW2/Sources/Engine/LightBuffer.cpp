@@ -0,0 +1,61 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    void LightBuffer::create() {
+        glGenBuffers(1, &m_uboId);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_uboId);
+        glBufferData(GL_UNIFORM_BUFFER, MAX_LIGHTS * sizeof(LightData), NULL, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, m_uboId);
+
+        m_dirty = true;
+        update();
+    }
+
+    void LightBuffer::setLight(int index, const Light& light) {
+        if (index < 0 || index >= MAX_LIGHTS) {
+            std::cout << "Error: Invalid light index " << index << ".\n";
+            std::cin.get();
+            return;
+        }
+
+        m_lightList[index] = light;
+        m_dirty = true;
+    }
+
+    void LightBuffer::update() {
+        if (!m_dirty) {
+            return;
+        }
+
+        LightData dataList[MAX_LIGHTS];
+
+        for (int i = 0; i < MAX_LIGHTS; i++) {
+            auto& light = m_lightList[i];
+            auto& data = dataList[i];
+
+            data.position = light.position;
+            data.type = light.type;
+            data.direction = light.direction;
+            data.angle = light.angle;
+            data.ambient = light.ambient;
+            data.attenuation = light.attenuation;
+            data.diffuse = light.diffuse;
+            data.padding0 = 0.0f;
+            data.specular = light.specular;
+            data.padding1 = 0.0f;
+        }
+
+        glBindBuffer(GL_UNIFORM_BUFFER, m_uboId);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(dataList), dataList);
+
+        m_dirty = false;
+    }
+
+    void LightBuffer::bindBlock(GLuint programId) {
+        GLuint index = glGetUniformBlockIndex(programId, "LightBlock");
+
+        if (index != GL_INVALID_INDEX) {
+            glUniformBlockBinding(programId, index, BINDING);
+        }
+    }
+}
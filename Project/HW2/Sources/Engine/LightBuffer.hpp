@@ -0,0 +1,54 @@
+#ifndef ENGINE_LIGHT_BUFFER_HPP
+#define ENGINE_LIGHT_BUFFER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Uniform buffer which holds the light list shared by all shaders. (Block "LightBlock", std140)
+    // Set the lights, then call update() once per frame.
+    class LightBuffer {
+    public:
+        // Binding point of the block. (See Shader::create().)
+        static const GLuint BINDING = 0;
+        // Maximum number of the lights.
+        static const int MAX_LIGHTS = 5;
+
+        // Create the buffer and bind it to the binding point.
+        void create();
+
+        void setLight(int index, const Light& light);
+
+        // Upload the lights if they changed.
+        void update();
+
+        // Connect the program's "LightBlock" to the binding point. (No-op if the program doesn't use it.)
+        static void bindBlock(GLuint programId);
+
+    private:
+        // std140 layout of a single light. (Must match the struct Light in the shaders.)
+        struct LightData {
+            glm::vec3 position;
+            GLint type;
+            glm::vec3 direction;
+            GLfloat angle;
+            glm::vec3 ambient;
+            GLfloat attenuation;
+            glm::vec3 diffuse;
+            GLfloat padding0;
+            glm::vec3 specular;
+            GLfloat padding1;
+        };
+
+        static_assert(sizeof(LightData) == 80, "LightData doesn't match the std140 layout.");
+
+        // List of light information.
+        std::vector<Light> m_lightList{ MAX_LIGHTS };
+        // Whether the list changed after the last upload.
+        bool m_dirty = true;
+
+        // UBO id.
+        GLuint m_uboId;
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "Engine.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+
+#include <windows.h>
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+namespace Engine {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string& path) {
+        HANDLE file = CreateFileA(
+                path.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                nullptr
+        );
+
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Error: File \"" + path + "\" does not exist.");
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+
+        m_fileHandle = file;
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        // Windows can't map an empty file.
+        if (m_size == 0) {
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            throw std::runtime_error("Error: Failed to map \"" + path + "\".");
+        }
+
+        m_mappingHandle = mapping;
+        m_data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (m_data == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("Error: Failed to map \"" + path + "\".");
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mappingHandle != nullptr) {
+            CloseHandle(m_mappingHandle);
+        }
+
+        if (m_fileHandle != nullptr) {
+            CloseHandle(m_fileHandle);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string& path) {
+        int file = open(path.c_str(), O_RDONLY);
+
+        if (file < 0) {
+            throw std::runtime_error("Error: File \"" + path + "\" does not exist.");
+        }
+
+        struct stat status{};
+
+        if (fstat(file, &status) != 0) {
+            close(file);
+            throw std::runtime_error("Error: Failed to read \"" + path + "\".");
+        }
+
+        m_size = static_cast<size_t>(status.st_size);
+
+        // mmap() rejects an empty range.
+        if (m_size > 0) {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (data == MAP_FAILED) {
+                close(file);
+                throw std::runtime_error("Error: Failed to map \"" + path + "\".");
+            }
+
+            m_data = static_cast<const unsigned char*>(data);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        close(file);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data != nullptr) {
+            munmap(const_cast<unsigned char*>(m_data), m_size);
+        }
+    }
+#endif
+
+    const unsigned char* MappedFile::getData() const {
+        return m_data;
+    }
+
+    size_t MappedFile::getSize() const {
+        return m_size;
+    }
+}
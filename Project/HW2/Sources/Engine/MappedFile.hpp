@@ -0,0 +1,31 @@
+#ifndef ENGINE_MAPPED_FILE_HPP
+#define ENGINE_MAPPED_FILE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Read-only memory mapping of a whole file.
+    class MappedFile {
+    public:
+        // Map the file. Throws if the file can't be opened or mapped.
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const unsigned char* getData() const;
+        size_t getSize() const;
+
+    private:
+        const unsigned char* m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#endif
+    };
+}
+
+#endif
@@ -4,27 +4,26 @@ namespace Engine {
     void Model::create() {
         // Create & bind a VAO.
         glGenVertexArrays(1, &m_vaoId);
-        glBindVertexArray(m_vaoId);
+        GLState::bindVertexArray(m_vaoId);
 
-        // Allocate VBO for each attribute.
-        initAttribute(0, 3, sizeof(glm::vec3));
-        initAttribute(1, 3, sizeof(glm::vec3));
-        initAttribute(2, 3, sizeof(glm::vec3));
-        initAttribute(3, 2, sizeof(glm::vec2));
+        // Interleave the attributes into one VBO.
+        m_usedVertexLayout = m_vertexLayout.fit(m_positionList, m_normalList, m_colorList, m_uvList);
 
-        // Initialize each attribute's VBO.
-        setAttribute(0, m_positionList);
-        setAttribute(1, m_normalList);
-        setAttribute(2, m_colorList);
-        setAttribute(3, m_uvList);
+        auto buffer = m_usedVertexLayout.pack(m_positionList, m_normalList, m_colorList, m_uvList);
+
+        glGenBuffers(1, &m_vboId);
+        glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
+        glBufferData(GL_ARRAY_BUFFER, buffer.size(), buffer.data(), GL_STATIC_DRAW);
+
+        m_usedVertexLayout.apply();
 
         // Unbind the VAO.
-        glBindVertexArray(0);
+        GLState::bindVertexArray(0);
     }
 
     void Model::draw() {
         // Update the uniforms.
-        glUseProgram(m_programId);
+        GLState::useProgram(m_programId);
 
         setUniform("u_modelMatrix", m_modelMatrix);
         setUniform("u_viewMatrix", m_viewMatrix);
@@ -38,29 +37,15 @@ namespace Engine {
         setUniform("u_material.specular", m_material.specular);
         setUniform("u_material.shininess", m_material.shininess);
 
-        for (int i = 0; i < m_lightList.size(); i++) {
-            auto& light = m_lightList[i];
-            std::string name = "u_lightList[" + std::to_string(i) + "]";
-
-            setUniform(name + ".type", light.type);
-            setUniform(name + ".position", light.position);
-            setUniform(name + ".direction", light.direction);
-            setUniform(name + ".ambient", light.ambient);
-            setUniform(name + ".diffuse", light.diffuse);
-            setUniform(name + ".specular", light.specular);
-            setUniform(name + ".angle", light.angle);
-            setUniform(name + ".attenuation", light.attenuation);
-        }
+        // (The lights come from the shared LightBuffer.)
 
-        // Bind the VAO.
-        glBindVertexArray(m_vaoId);
+        // Bind the VAO. (It stays bound. The next draw binds its own one if needed.)
+        GLState::bindVertexArray(m_vaoId);
+        m_usedVertexLayout.applyDefaults();
 
         // Draw the model.
-        glPolygonMode(GL_FRONT_AND_BACK, (m_fill ? GL_FILL : GL_LINE));
+        GLState::setPolygonMode(m_fill ? GL_FILL : GL_LINE);
         glDrawArrays(m_drawMode, 0, static_cast<GLsizei>(m_positionList.size()));
-
-        // Unbind the VAO.
-        glBindVertexArray(0);
     }
 
     glm::mat4 Model::getModelMatrix() const {
@@ -71,6 +56,10 @@ namespace Engine {
         m_fill = fill;
     }
 
+    void Model::setVertexLayout(const VertexLayout& layout) {
+        m_vertexLayout = layout;
+    }
+
     void Model::setModelMatrix(const glm::mat4& matrix) {
         m_modelMatrix = matrix;
     }
@@ -83,10 +72,6 @@ namespace Engine {
         m_projectionMatrix = matrix;
     }
 
-    void Model::setLight(int index, const Light& light) {
-        m_lightList[index] = light;
-    }
-
     void Model::setMaterial(const Material& material) {
         m_material = material;
     }
@@ -103,37 +88,11 @@ namespace Engine {
         m_programId = shader.getProgramId();
     }
 
-    void Model::initAttribute(GLuint index, GLint size, GLsizei stride) {
-        // Generate a VBO for the attribute.
-        GLuint id;
-
-        glGenBuffers(1, &id);
-        m_attributeCache[index] = id;
-
-        // Set the index of the attribute.
-        glEnableVertexAttribArray(index);
-        glBindBuffer(GL_ARRAY_BUFFER, m_attributeCache[index]);
-
-        glVertexAttribPointer(
-            index,    // index
-            size,     // size
-            GL_FLOAT, // type
-            GL_FALSE, // normalized
-            stride,   // stride
-            nullptr   // pointer
-        );
-    }
-
-    template<typename T>
-    void Model::setAttribute(GLuint index, const std::vector<T>& buffer) {
-        glBindBuffer(GL_ARRAY_BUFFER, m_attributeCache[index]);
+    void Model::updateVertices() {
+        auto buffer = m_usedVertexLayout.pack(m_positionList, m_normalList, m_colorList, m_uvList);
 
-        glBufferData(
-            GL_ARRAY_BUFFER,
-            buffer.size() * sizeof(T),
-            &(buffer[0]),
-            GL_STATIC_DRAW
-        );
+        glBindBuffer(GL_ARRAY_BUFFER, m_vboId);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, buffer.size(), buffer.data());
     }
 
     void Model::setUniform(const std::string& name, GLint value) {
@@ -17,11 +17,13 @@ namespace Engine {
 
         void setFill(bool fill);
 
+        // Choose how the vertices are stored. (Call before create().)
+        void setVertexLayout(const VertexLayout& layout);
+
         void setModelMatrix(const glm::mat4& matrix);
         virtual void setViewMatrix(const glm::mat4& matrix);
         virtual void setProjectionMatrix(const glm::mat4& matrix);
 
-        virtual void setLight(int index, const Light& light);
         virtual void setMaterial(const Material& material);
 
         virtual void setTexture(const Texture& texture);
@@ -29,11 +31,8 @@ namespace Engine {
         virtual void setShader(const Shader& shader);
 
     protected:
-        // Generate a VBO for the attribute and set the index.
-        void initAttribute(GLuint index, GLint size, GLsizei stride);
-
-        // Set the value of the attribute.
-        template<typename T> void setAttribute(GLuint index, const std::vector<T>& buffer);
+        // Upload the lists again after changing them. (The number of vertices should stay the same.)
+        void updateVertices();
 
         // Set the value of the uniform.
         void setUniform(const std::string& name, GLint value);
@@ -48,11 +47,16 @@ namespace Engine {
         std::vector<glm::vec3> m_positionList;
         // List of normal vectors.
         std::vector<glm::vec3> m_normalList;
-        // List of colors. (RGB)
+        // List of colors. (RGB, optional: White if empty)
         std::vector<glm::vec3> m_colorList;
-        // List of texture coordinates. (UV)
+        // List of texture coordinates. (UV, optional)
         std::vector<glm::vec2> m_uvList;
 
+        // Format of the vertices in the VBO.
+        VertexLayout m_vertexLayout;
+        // Same, after dropping the missing attributes. (See VertexLayout::fit().)
+        VertexLayout m_usedVertexLayout;
+
         // Model matrix.
         glm::mat4 m_modelMatrix;
         // View matrix. (= inverse(Eye's model matrix))
@@ -62,8 +66,6 @@ namespace Engine {
 
         // Material information.
         Material m_material;
-        // List of light information. (Maximum: 5)
-        std::vector<Light> m_lightList{ 5 };
 
         // Whether we draw the whole object or only its wireframe.
         bool m_fill = true;
@@ -78,9 +80,8 @@ namespace Engine {
         GLuint m_programId;
         // VAO id.
         GLuint m_vaoId;
-
-        // Map of (attribute index, VBO id).
-        std::map<GLuint, GLuint> m_attributeCache;
+        // VBO id. (All the attributes are interleaved in it.)
+        GLuint m_vboId;
         // Map of (uniform name, uniform location).
         std::map<std::string, GLint> m_uniformCache;
     };
@@ -12,18 +12,20 @@ namespace Engine {
     }
 
     void Shader::create() {
-        // Compile & check the vertex shader.
+        // Compile the shaders. (Both before checking either, so the driver can compile them in parallel.)
         GLuint vertexShaderId = compileShader(GL_VERTEX_SHADER, readFile(m_vertexShaderPath));
-        checkShader(vertexShaderId);
-
-        // Compile & check the fragment shader.
         GLuint fragmentShaderId = compileShader(GL_FRAGMENT_SHADER, readFile(m_fragmentShaderPath));
+
+        checkShader(vertexShaderId);
         checkShader(fragmentShaderId);
 
         // Create a program and attach the shaders.
         GLuint programId = linkProgram(vertexShaderId, fragmentShaderId);
         checkProgram(programId);
 
+        // Connect the shared uniform blocks. (GLSL 3.30 has no layout(binding = ...).)
+        LightBuffer::bindBlock(programId);
+
         m_programId = programId;
     }
 
@@ -42,11 +44,8 @@ static std::string readFile(const std::string& path) {
         return "";
     }
 
-    std::string line = "";
-
-    while (std::getline(stream, line)) {
-        data += "\n" + line;
-    }
+    // (Read it at once, not line by line.)
+    data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
 
     stream.close();
     return data;
@@ -94,7 +93,7 @@ static void checkProgram(GLuint id) {
     GLint result = GL_FALSE;
     GLint logLength = 0;
 
-    glGetProgramiv(id, GL_COMPILE_STATUS, &result);
+    glGetProgramiv(id, GL_LINK_STATUS, &result);
     glGetProgramiv(id, GL_INFO_LOG_LENGTH, &logLength);
 
     if (logLength > 1) {
@@ -1,25 +1,49 @@
 #include "Engine.hpp"
 
-struct PPM {
+// Image read from a PNM (P2, P3, P5, P6) or PAM (P7) file.
+struct PNMImage {
+    std::unique_ptr<Engine::MappedFile> file;
     int width;
     int height;
-    std::string magicNumber;
-    std::string maxValue;
-    std::vector<char> data;
+    // Samples per pixel. (1: Gray, 2: Gray + alpha, 3: RGB, 4: RGBA)
+    int channelCount;
+    // GL_UNSIGNED_BYTE or GL_UNSIGNED_SHORT.
+    GLenum type;
+    // Binary 16-bit samples are big-endian.
+    bool isBigEndian;
+    // Points into the mapping if its samples can be used as they are. (Binary, max value 255 or 65535.)
+    // Otherwise into 'convertedData'.
+    const GLvoid* data;
+    std::vector<unsigned char> convertedData;
 };
 
 // We assign even units(2, 4, ...) for the textures.
 // (Odd units are used for the FBOs.)
 static GLint currTextureUnit = 2;
 
-static std::unique_ptr<PPM> readPPM(std::string& path);
+static std::unique_ptr<PNMImage> readPNM(const std::string& path);
+
+// Skip the whitespace and the comments ("# ..." until the end of the line) of the header.
+static void skipSpace(const unsigned char* data, size_t size, size_t& offset);
+
+// Read the next token of the header. (Empty at the end of the file.)
+static std::string readToken(const unsigned char* data, size_t size, size_t& offset);
+
+static int parseValue(const std::string& token, const std::string& path);
+
+static bool isLittleEndianHost();
 
 namespace Engine {
     Texture::Texture(const std::string& path) : m_texturePath(path) {}
 
     void Texture::create() {
+        static const GLenum FORMATS[4] = { GL_RED, GL_RG, GL_RGB, GL_RGBA };
+        static const GLint BYTE_FORMATS[4] = { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
+        static const GLint SHORT_FORMATS[4] = { GL_R16, GL_RG16, GL_RGB16, GL_RGBA16 };
+
         // Read the image.
-        auto image = readPPM(m_texturePath);
+        auto image = readPNM(m_texturePath);
+        auto channelIndex = image->channelCount - 1;
 
         // Generate a texture unit.
         m_textureUnit = currTextureUnit;
@@ -27,21 +51,36 @@ namespace Engine {
 
         // Create & bind the texture.
         glGenTextures(1, &m_textureId);
-        glActiveTexture(GL_TEXTURE0 + m_textureUnit);
-        glBindTexture(GL_TEXTURE_2D, m_textureId);
+        GLState::bindTexture(m_textureUnit, GL_TEXTURE_2D, m_textureId);
+
+        // The rows are packed, and GL swaps the big-endian samples itself. (So the mapping is uploaded as is.)
+        auto isSwapped = image->type == GL_UNSIGNED_SHORT && image->isBigEndian && isLittleEndianHost();
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_SWAP_BYTES, isSwapped ? GL_TRUE : GL_FALSE);
 
         glTexImage2D(
             GL_TEXTURE_2D,
             0,
-            GL_RGB,
+            image->type == GL_UNSIGNED_SHORT ? SHORT_FORMATS[channelIndex] : BYTE_FORMATS[channelIndex],
             image->width,
             image->height,
             0,
-            GL_RGB,
-            GL_UNSIGNED_BYTE,
-            &(image->data[0])
+            FORMATS[channelIndex],
+            image->type,
+            image->data
         );
 
+        glPixelStorei(GL_UNPACK_SWAP_BYTES, GL_FALSE);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        // Gray images are sampled as gray, not red.
+        if (image->channelCount <= 2) {
+            GLint swizzle[4] = { GL_RED, GL_RED, GL_RED, image->channelCount == 2 ? GL_GREEN : GL_ONE };
+
+            glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+        }
+
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     }
@@ -51,24 +90,196 @@ namespace Engine {
     }
 }
 
-static std::unique_ptr<PPM> readPPM(std::string& path) {
-    auto image = std::make_unique<PPM>();
-    std::ifstream stream(path, std::ios::binary);
+static std::unique_ptr<PNMImage> readPNM(const std::string& path) {
+    auto image = std::make_unique<PNMImage>();
 
-    if (!stream.is_open()) {
-        std::cout << "Error: File \"" << path << "\" does not exist.\n";
-        std::cin.get();
-        return image;
+    // (Throws if the file doesn't exist.)
+    image->file = std::make_unique<Engine::MappedFile>(path);
+
+    auto data = image->file->getData();
+    auto size = image->file->getSize();
+
+    if (size < 2 || data[0] != 'P' || data[1] < '2' || data[1] > '7' || data[1] == '4') {
+        throw std::runtime_error("Error: \"" + path + "\" is not a PPM, PGM or PAM file. (P2, P3, P5, P6 or P7)");
     }
 
+    auto kind = data[1];
+    auto isASCII = kind == '2' || kind == '3';
+    size_t offset = 2;
+    int maxValue = 0;
+
     // Read the header.
-    stream >> image->magicNumber >> image->width >> image->height >> image->maxValue;
-    stream.ignore(256, '\n');
+    if (kind == '7') {
+        std::string tupleType;
+
+        image->width = 0;
+        image->height = 0;
+        image->channelCount = 0;
+
+        while (true) {
+            auto key = readToken(data, size, offset);
+
+            if (key == "ENDHDR") {
+                break;
+            }
+            else if (key.empty()) {
+                throw std::runtime_error("Error: The header of \"" + path + "\" has no ENDHDR.");
+            }
+            else if (key == "WIDTH") {
+                image->width = parseValue(readToken(data, size, offset), path);
+            }
+            else if (key == "HEIGHT") {
+                image->height = parseValue(readToken(data, size, offset), path);
+            }
+            else if (key == "DEPTH") {
+                image->channelCount = parseValue(readToken(data, size, offset), path);
+            }
+            else if (key == "MAXVAL") {
+                maxValue = parseValue(readToken(data, size, offset), path);
+            }
+            else if (key == "TUPLTYPE") {
+                tupleType = readToken(data, size, offset);
+            }
+            else {
+                throw std::runtime_error("Error: Unknown header field \"" + key + "\" in \"" + path + "\".");
+            }
+        }
+
+        // (The TUPLTYPE is optional, but it must agree with the DEPTH if given.)
+        auto isTupleTypeValid = tupleType.empty()
+            || (tupleType == "GRAYSCALE" && image->channelCount == 1)
+            || (tupleType == "GRAYSCALE_ALPHA" && image->channelCount == 2)
+            || (tupleType == "RGB" && image->channelCount == 3)
+            || (tupleType == "RGB_ALPHA" && image->channelCount == 4);
+
+        if (!isTupleTypeValid || image->channelCount < 1 || image->channelCount > 4) {
+            throw std::runtime_error("Error: Unsupported TUPLTYPE or DEPTH in \"" + path + "\".");
+        }
+    }
+    else {
+        image->width = parseValue(readToken(data, size, offset), path);
+        image->height = parseValue(readToken(data, size, offset), path);
+        maxValue = parseValue(readToken(data, size, offset), path);
+        image->channelCount = kind == '2' || kind == '5' ? 1 : 3;
+    }
+
+    // The pixels start after the single whitespace at the end of the header.
+    offset++;
+
+    if (image->width <= 0 || image->height <= 0 || maxValue <= 0 || maxValue > 65535) {
+        throw std::runtime_error("Error: Invalid size or max value in \"" + path + "\".");
+    }
+
+    image->type = maxValue > 255 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_BYTE;
+    image->isBigEndian = true;
+
+    auto sampleCount = static_cast<size_t>(image->width) * image->height * image->channelCount;
+    auto sampleSize = static_cast<size_t>(image->type == GL_UNSIGNED_SHORT ? 2 : 1);
+
+    // Binary samples at their full range: Use the mapping directly.
+    if (!isASCII && (maxValue == 255 || maxValue == 65535)) {
+        if (offset > size || size - offset < sampleCount * sampleSize) {
+            throw std::runtime_error("Error: \"" + path + "\" is truncated.");
+        }
+
+        image->data = data + offset;
+
+        return image;
+    }
 
-    // Read the data.
-    image->data.resize(image->width * image->height * 3);
-    stream.read(&(image->data[0]), image->data.size());
+    // Otherwise, read the samples and stretch them to the full range. (In the host's byte order.)
+    // Check that the file can hold them first, so a bogus header can't make us allocate gigabytes.
+    // (ASCII samples take at least 2 bytes: A digit and a separator.)
+    auto availableCount = offset > size ? 0 : (isASCII ? (size - offset + 1) / 2 : (size - offset) / sampleSize);
+
+    if (sampleCount > availableCount) {
+        throw std::runtime_error("Error: \"" + path + "\" is truncated.");
+    }
+
+    auto fullValue = static_cast<uint32_t>(image->type == GL_UNSIGNED_SHORT ? 65535 : 255);
+
+    image->convertedData.resize(sampleCount * sampleSize);
+    image->isBigEndian = !isLittleEndianHost();
+
+    for (size_t i = 0; i < sampleCount; i++) {
+        uint32_t value;
+
+        if (isASCII) {
+            auto token = readToken(data, size, offset);
+
+            if (token.empty()) {
+                throw std::runtime_error("Error: \"" + path + "\" is truncated.");
+            }
+
+            value = static_cast<uint32_t>(parseValue(token, path));
+        }
+        else {
+            if (offset > size || size - offset < sampleSize) {
+                throw std::runtime_error("Error: \"" + path + "\" is truncated.");
+            }
+
+            value = sampleSize == 2 ? (data[offset] << 8u) | data[offset + 1] : data[offset];
+            offset += sampleSize;
+        }
+
+        value = (std::min(value, static_cast<uint32_t>(maxValue)) * fullValue + maxValue / 2) / maxValue;
+
+        if (sampleSize == 2) {
+            auto sample = static_cast<uint16_t>(value);
+
+            std::memcpy(&image->convertedData[i * 2], &sample, 2);
+        }
+        else {
+            image->convertedData[i] = static_cast<unsigned char>(value);
+        }
+    }
+
+    image->data = image->convertedData.data();
 
-    stream.close();
     return image;
 }
+
+static void skipSpace(const unsigned char* data, size_t size, size_t& offset) {
+    while (offset < size) {
+        if (data[offset] == '#') {
+            while (offset < size && data[offset] != '\n') {
+                offset++;
+            }
+        }
+        else if (std::isspace(data[offset])) {
+            offset++;
+        }
+        else {
+            break;
+        }
+    }
+}
+
+static std::string readToken(const unsigned char* data, size_t size, size_t& offset) {
+    skipSpace(data, size, offset);
+
+    auto start = offset;
+
+    while (offset < size && !std::isspace(data[offset]) && data[offset] != '#') {
+        offset++;
+    }
+
+    return std::string(reinterpret_cast<const char*>(data + start), offset - start);
+}
+
+static int parseValue(const std::string& token, const std::string& path) {
+    if (token.empty() || token.size() > 9 || !std::all_of(token.begin(), token.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        throw std::runtime_error("Error: Invalid number \"" + token + "\" in \"" + path + "\".");
+    }
+
+    return std::stoi(token);
+}
+
+static bool isLittleEndianHost() {
+    uint16_t value = 1;
+    unsigned char firstByte;
+
+    std::memcpy(&firstByte, &value, 1);
+
+    return firstByte == 1;
+}
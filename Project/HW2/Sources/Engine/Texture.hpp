@@ -3,8 +3,9 @@
 
 #include "Engine.hpp"
 
-// Since SOIL does not work in my computer, I wrote a simple PPM reader.
-// Currently, only .ppm files without commments ("# blahblah...") are supported.
+// Since SOIL does not work in my computer, I wrote a simple PNM reader.
+// It reads .ppm/.pgm (P2, P3, P5, P6) and .pam (P7) files with 8 or 16 bits per sample.
+// The file is memory-mapped, and binary samples at their full range (255 or 65535) go to GL straight from it.
 
 namespace Engine {
     // Class for handling a texture.
@@ -12,7 +13,7 @@ namespace Engine {
     public:
         Texture(const std::string& path);
 
-        // Read & bind the texture.
+        // Read & bind the texture. (Throws if the file is missing or invalid.)
         virtual void create();
 
         GLint getTextureUnit() const;
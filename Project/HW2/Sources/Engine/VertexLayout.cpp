@@ -0,0 +1,199 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    static const float MAX_HALF = 65504.0f;
+
+    // Turn a byte offset into the pointer argument of glVertexAttribPointer().
+    static const void* toPointer(GLsizei offset) {
+        return reinterpret_cast<const void*>(static_cast<uintptr_t>(offset));
+    }
+
+    static bool isInRange(const glm::vec3& value, float min, float max) {
+        return !glm::any(glm::lessThan(value, glm::vec3(min))) && !glm::any(glm::greaterThan(value, glm::vec3(max)));
+    }
+
+    VertexLayout::VertexLayout(
+        PositionFormat positionFormat,
+        NormalFormat normalFormat,
+        ColorFormat colorFormat,
+        UVFormat uvFormat
+    ) : m_positionFormat(positionFormat),
+        m_normalFormat(normalFormat),
+        m_colorFormat(colorFormat),
+        m_uvFormat(uvFormat) {
+        m_normalOffset = (positionFormat == POSITION_FLOAT) ? 12 : 8;
+        m_colorOffset = m_normalOffset + ((normalFormat == NORMAL_FLOAT) ? 12 : (normalFormat == NORMAL_PACKED) ? 4 : 0);
+        m_uvOffset = m_colorOffset + ((colorFormat == COLOR_FLOAT) ? 12 : (colorFormat == COLOR_UNORM8) ? 4 : 0);
+        m_stride = m_uvOffset + ((uvFormat == UV_FLOAT) ? 8 : (uvFormat == UV_UNORM16) ? 4 : 0);
+    }
+
+    VertexLayout VertexLayout::compact() {
+        return VertexLayout(POSITION_HALF, NORMAL_PACKED, COLOR_UNORM8, UV_UNORM16);
+    }
+
+    VertexLayout VertexLayout::fit(
+        const std::vector<glm::vec3>& positionList,
+        const std::vector<glm::vec3>& normalList,
+        const std::vector<glm::vec3>& colorList,
+        const std::vector<glm::vec2>& uvList
+    ) const {
+        auto count = positionList.size();
+        auto positionFormat = m_positionFormat;
+        auto normalFormat = (normalList.size() < count) ? NORMAL_NONE : m_normalFormat;
+        auto colorFormat = (colorList.size() < count) ? COLOR_NONE : m_colorFormat;
+        auto uvFormat = (uvList.size() < count) ? UV_NONE : m_uvFormat;
+
+        for (size_t i = 0; i < count; i++) {
+            if (positionFormat == POSITION_HALF && !isInRange(positionList[i], -MAX_HALF, MAX_HALF)) {
+                positionFormat = POSITION_FLOAT;
+            }
+
+            // (Normals which aren't normalized keep their length as long as it fits.)
+            if (normalFormat == NORMAL_PACKED && !isInRange(normalList[i], -1.0f, 1.0f)) {
+                normalFormat = NORMAL_FLOAT;
+            }
+
+            if (colorFormat == COLOR_UNORM8 && !isInRange(colorList[i], 0.0f, 1.0f)) {
+                colorFormat = COLOR_FLOAT;
+            }
+
+            if (uvFormat == UV_UNORM16 && !isInRange(glm::vec3(uvList[i], 0.0f), 0.0f, 1.0f)) {
+                uvFormat = UV_FLOAT;
+            }
+        }
+
+        return VertexLayout(positionFormat, normalFormat, colorFormat, uvFormat);
+    }
+
+    std::vector<unsigned char> VertexLayout::pack(
+        const std::vector<glm::vec3>& positionList,
+        const std::vector<glm::vec3>& normalList,
+        const std::vector<glm::vec3>& colorList,
+        const std::vector<glm::vec2>& uvList
+    ) const {
+        auto count = positionList.size();
+        std::vector<unsigned char> buffer(count * m_stride);
+
+        for (size_t i = 0; i < count; i++) {
+            auto vertex = buffer.data() + i * m_stride;
+
+            if (m_positionFormat == POSITION_FLOAT) {
+                std::memcpy(vertex, &positionList[i], sizeof(glm::vec3));
+            }
+            else {
+                uint16_t half[4] = {
+                    glm::packHalf1x16(positionList[i].x),
+                    glm::packHalf1x16(positionList[i].y),
+                    glm::packHalf1x16(positionList[i].z),
+                    0
+                };
+
+                std::memcpy(vertex, half, sizeof(half));
+            }
+
+            if (m_normalFormat == NORMAL_FLOAT) {
+                std::memcpy(vertex + m_normalOffset, &normalList[i], sizeof(glm::vec3));
+            }
+            else if (m_normalFormat == NORMAL_PACKED) {
+                uint32_t packed = glm::packSnorm3x10_1x2(glm::vec4(normalList[i], 0.0f));
+
+                std::memcpy(vertex + m_normalOffset, &packed, sizeof(packed));
+            }
+
+            if (m_colorFormat == COLOR_FLOAT) {
+                std::memcpy(vertex + m_colorOffset, &colorList[i], sizeof(glm::vec3));
+            }
+            else if (m_colorFormat == COLOR_UNORM8) {
+                uint8_t unorm[4] = {
+                    glm::packUnorm1x8(colorList[i].r),
+                    glm::packUnorm1x8(colorList[i].g),
+                    glm::packUnorm1x8(colorList[i].b),
+                    0
+                };
+
+                std::memcpy(vertex + m_colorOffset, unorm, sizeof(unorm));
+            }
+
+            if (m_uvFormat == UV_FLOAT) {
+                std::memcpy(vertex + m_uvOffset, &uvList[i], sizeof(glm::vec2));
+            }
+            else if (m_uvFormat == UV_UNORM16) {
+                uint16_t unorm[2] = {
+                    glm::packUnorm1x16(uvList[i].x),
+                    glm::packUnorm1x16(uvList[i].y)
+                };
+
+                std::memcpy(vertex + m_uvOffset, unorm, sizeof(unorm));
+            }
+        }
+
+        return buffer;
+    }
+
+    void VertexLayout::apply() const {
+        // Position.
+        glEnableVertexAttribArray(0);
+
+        if (m_positionFormat == POSITION_FLOAT) {
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, m_stride, toPointer(0));
+        }
+        else {
+            glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, m_stride, toPointer(0));
+        }
+
+        // Normal.
+        if (m_normalFormat == NORMAL_NONE) {
+            glDisableVertexAttribArray(1);
+        }
+        else {
+            glEnableVertexAttribArray(1);
+
+            if (m_normalFormat == NORMAL_FLOAT) {
+                glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, m_stride, toPointer(m_normalOffset));
+            }
+            else {
+                glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, m_stride, toPointer(m_normalOffset));
+            }
+        }
+
+        // Color.
+        if (m_colorFormat == COLOR_NONE) {
+            glDisableVertexAttribArray(2);
+        }
+        else {
+            glEnableVertexAttribArray(2);
+
+            if (m_colorFormat == COLOR_FLOAT) {
+                glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, m_stride, toPointer(m_colorOffset));
+            }
+            else {
+                glVertexAttribPointer(2, 3, GL_UNSIGNED_BYTE, GL_TRUE, m_stride, toPointer(m_colorOffset));
+            }
+        }
+
+        // UV.
+        if (m_uvFormat == UV_NONE) {
+            glDisableVertexAttribArray(3);
+        }
+        else {
+            glEnableVertexAttribArray(3);
+
+            if (m_uvFormat == UV_FLOAT) {
+                glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, m_stride, toPointer(m_uvOffset));
+            }
+            else {
+                glVertexAttribPointer(3, 2, GL_UNSIGNED_SHORT, GL_TRUE, m_stride, toPointer(m_uvOffset));
+            }
+        }
+    }
+
+    void VertexLayout::applyDefaults() const {
+        if (m_colorFormat == COLOR_NONE) {
+            glVertexAttrib3f(2, 1.0f, 1.0f, 1.0f);
+        }
+    }
+
+    GLsizei VertexLayout::getStride() const {
+        return m_stride;
+    }
+}
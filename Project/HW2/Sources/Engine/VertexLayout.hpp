@@ -0,0 +1,83 @@
+#ifndef ENGINE_VERTEX_LAYOUT_HPP
+#define ENGINE_VERTEX_LAYOUT_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // How the vertices of a model are stored: The attributes are interleaved in one VBO, each in its own format.
+    // (Attribute locations: 0 = position, 1 = normal, 2 = color, 3 = uv.)
+    class VertexLayout {
+    public:
+        enum PositionFormat {
+            POSITION_FLOAT, // 3 floats. (12 bytes)
+            POSITION_HALF   // 3 half floats, padded to 8 bytes.
+        };
+
+        enum NormalFormat {
+            NORMAL_NONE,
+            NORMAL_FLOAT,   // 3 floats. (12 bytes)
+            NORMAL_PACKED   // GL_INT_2_10_10_10_REV, normalized. Only holds components in [-1, 1]. (4 bytes)
+        };
+
+        enum ColorFormat {
+            COLOR_NONE,     // The shaders see white.
+            COLOR_FLOAT,    // 3 floats. (12 bytes)
+            COLOR_UNORM8    // 3 GL_UNSIGNED_BYTEs, normalized, padded to 4 bytes. Only holds colors in [0, 1].
+        };
+
+        enum UVFormat {
+            UV_NONE,
+            UV_FLOAT,       // 2 floats. (8 bytes)
+            UV_UNORM16      // 2 GL_UNSIGNED_SHORTs, normalized. Only holds UVs in [0, 1]. (4 bytes)
+        };
+
+        VertexLayout(
+            PositionFormat positionFormat = POSITION_FLOAT,
+            NormalFormat normalFormat = NORMAL_FLOAT,
+            ColorFormat colorFormat = COLOR_FLOAT,
+            UVFormat uvFormat = UV_FLOAT
+        );
+
+        // Half float positions, packed normals, 8-bit colors and 16-bit UVs. (20 bytes per vertex, instead of 44.)
+        static VertexLayout compact();
+
+        // Returns the layout we can really use for the data: The attributes without data are dropped,
+        // and the compact formats fall back to floats if the data doesn't fit them.
+        VertexLayout fit(
+            const std::vector<glm::vec3>& positionList,
+            const std::vector<glm::vec3>& normalList,
+            const std::vector<glm::vec3>& colorList,
+            const std::vector<glm::vec2>& uvList
+        ) const;
+
+        // Convert the lists and interleave them.
+        std::vector<unsigned char> pack(
+            const std::vector<glm::vec3>& positionList,
+            const std::vector<glm::vec3>& normalList,
+            const std::vector<glm::vec3>& colorList,
+            const std::vector<glm::vec2>& uvList
+        ) const;
+
+        // Point the attributes to the bound VBO. (The VAO should be bound.)
+        void apply() const;
+
+        // Set the values of the omitted attributes. (They are not stored in the VAO, so call this before drawing.)
+        void applyDefaults() const;
+
+        GLsizei getStride() const;
+
+    private:
+        PositionFormat m_positionFormat;
+        NormalFormat m_normalFormat;
+        ColorFormat m_colorFormat;
+        UVFormat m_uvFormat;
+
+        // Byte offsets in a vertex.
+        GLsizei m_normalOffset = 0;
+        GLsizei m_colorOffset = 0;
+        GLsizei m_uvOffset = 0;
+        GLsizei m_stride = 0;
+    };
+}
+
+#endif
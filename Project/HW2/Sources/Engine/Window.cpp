@@ -4,6 +4,9 @@ namespace Engine {
     // Map for finding Window from GLFWwindow.
     static std::map<GLFWwindow*, Window*> windowMap;
 
+    // Longest time a frame can advance the simulation. (After a stall, skip the time instead of catching up.)
+    static const double MAX_FRAME_TIME = 0.25;
+
     Window::Window(int width, int height, const std::string& title)
         : m_windowWidth(width), m_windowHeight(height), m_title(title) {
     }
@@ -34,6 +37,7 @@ namespace Engine {
         }
 
         glfwMakeContextCurrent(m_context);
+        glfwSwapInterval(m_swapInterval);
 
         // Initialize GLEW.
         glewExperimental = GL_TRUE;
@@ -63,10 +67,16 @@ namespace Engine {
         // Render until ESCAPE key or X button is pressed.
         onStart();
 
+        m_lastFrameTime = std::chrono::steady_clock::now();
+        m_nextFrameTime = m_lastFrameTime;
+
         do {
+            update();
+            GLState::beginFrame();
             onDraw();
             glfwSwapBuffers(m_context);
             glfwPollEvents();
+            waitForNextFrame();
         } while (glfwGetKey(m_context, GLFW_KEY_ESCAPE) != GLFW_PRESS
             && !glfwWindowShouldClose(m_context));
 
@@ -74,10 +84,69 @@ namespace Engine {
 
         // Close the window.
         glfwTerminate();
+        m_context = nullptr;
 
         return 0;
     }
 
+    void Window::setUpdateRate(double rate) {
+        if (rate > 0.0) {
+            m_updateStep = 1.0 / rate;
+        }
+    }
+
+    void Window::setSwapInterval(int interval) {
+        m_swapInterval = interval;
+
+        // (Applied when the window is created, if it isn't yet.)
+        if (m_context != nullptr) {
+            glfwSwapInterval(interval);
+        }
+    }
+
+    void Window::setFrameLimit(double rate) {
+        m_framePeriod = rate > 0.0 ? 1.0 / rate : 0.0;
+    }
+
+    float Window::getInterpolation() const {
+        return m_interpolation;
+    }
+
+    void Window::update() {
+        auto now = std::chrono::steady_clock::now();
+        auto frameTime = std::chrono::duration<double>(now - m_lastFrameTime).count();
+
+        m_lastFrameTime = now;
+        m_accumulatedTime += std::min(frameTime, MAX_FRAME_TIME);
+
+        while (m_accumulatedTime >= m_updateStep) {
+            onUpdate(static_cast<float>(m_updateStep));
+            m_accumulatedTime -= m_updateStep;
+        }
+
+        m_interpolation = static_cast<float>(m_accumulatedTime / m_updateStep);
+    }
+
+    void Window::waitForNextFrame() {
+        if (m_framePeriod <= 0.0) {
+            return;
+        }
+
+        m_nextFrameTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(m_framePeriod)
+        );
+
+        auto now = std::chrono::steady_clock::now();
+
+        // Too late: Start over from now, instead of rushing the next frames.
+        if (m_nextFrameTime < now) {
+            m_nextFrameTime = now;
+            return;
+        }
+
+        std::this_thread::sleep_until(m_nextFrameTime);
+    }
+
     void Window::windowSizeCallback(GLFWwindow* context, int width, int height) {
         auto window = windowMap[context];
 
@@ -5,6 +5,8 @@
 
 namespace Engine {
     // Class for using GLFW and GLEW easily. Just make a subclass, override onXXX(), and call run().
+    // The simulation runs in fixed steps apart from the frame rate: Move things in onUpdate(), and draw them
+    // between their last two states with getInterpolation().
     class Window {
     public:
         Window(int width, int height, const std::string& title);
@@ -12,9 +14,18 @@ namespace Engine {
         // Create the window and start rendering. When it stops, close the window and return the exit code.
         int run();
 
+        // Number of the onUpdate() calls per second. (Default: 120)
+        void setUpdateRate(double rate);
+        // Wait for this many vertical blanks in each frame. (Default: 1, 0: Uncapped)
+        void setSwapInterval(int interval);
+        // Sleep to keep the frame rate under this. (0: No limit, default)
+        void setFrameLimit(double rate);
+
     protected:
         // Called when we're ready to render.
         virtual void onStart() {};
+        // Called in each fixed step. (dt: Length of the step in seconds.)
+        virtual void onUpdate(float dt) {};
         // Called in each frame.
         virtual void onDraw() {};
         // Called when rendering is terminated.
@@ -29,7 +40,15 @@ namespace Engine {
         // Called when we press the key.
         virtual void onKeyPress(int key) {};
 
+        // How far the frame is from the last onUpdate() to the next one, in [0, 1].
+        float getInterpolation() const;
+
     private:
+        // Call onUpdate() for the time which passed since the last frame.
+        void update();
+        // Sleep until the next frame is due.
+        void waitForNextFrame();
+
         static void windowSizeCallback(GLFWwindow* context, int width, int height);
         static void mouseButtonCallback(GLFWwindow* context, int button, int action, int mods);
         static void cursorPosCallback(GLFWwindow* context, double x, double y);
@@ -49,7 +68,18 @@ namespace Engine {
         std::string m_title;
 
         // GLFW window object.
-        GLFWwindow* m_context;
+        GLFWwindow* m_context = nullptr;
+
+        // Simulation time. (Seconds)
+        double m_updateStep = 1.0 / 120.0;
+        double m_accumulatedTime = 0.0;
+        float m_interpolation = 0.0f;
+
+        // Frame pacing.
+        int m_swapInterval = 1;
+        double m_framePeriod = 0.0;
+        std::chrono::steady_clock::time_point m_lastFrameTime;
+        std::chrono::steady_clock::time_point m_nextFrameTime;
     };
 }
 
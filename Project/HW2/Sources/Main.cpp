@@ -61,6 +61,9 @@ public:
         0.1f
     };
 
+    // Light list shared by the shaders.
+    Engine::LightBuffer lightBuffer;
+
     // Models.
     App::DisplayModel displayModel{ 1.8f, -0.9f, -0.9f };
     App::WallModel wallModel{ 2.0f, -1.0f, -1.0f, -1.0f };
@@ -81,6 +84,10 @@ public:
     float spotLightAngle = 0.0f;
     bool enableBlur = false;
 
+    // Light angles before the last update. (Drawn between these and the current ones.)
+    float lastPointLightArcsin = 0.0f;
+    float lastSpotLightAngle = 0.0f;
+
     Scene() : Engine::Window(600, 400, "Homework 2: 20130295 - Hunmin Park") {
         std::cout
             << "+-----------------------------+\n"
@@ -92,18 +99,22 @@ public:
 
     void onStart() override {
         // Depth test.
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
+        Engine::GLState::setDepthTest(true, GL_LESS);
 
         // Backface culling.
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        Engine::GLState::setCullFace(true, GL_BACK);
 
         // Create the shaders.
         defaultShader.create();
         lightingShader.create();
         blurShader.create();
 
+        // Create the lights.
+        lightBuffer.setLight(0, directionalLight);
+        lightBuffer.setLight(1, pointLight);
+        lightBuffer.setLight(2, spotLight);
+        lightBuffer.create();
+
         // Create the textures.
         wallTexture.create();
         wallNormalMap.create();
@@ -122,23 +133,22 @@ public:
         wallModel.setShader(lightingShader);
         wallModel.setTexture(wallTexture);
         wallModel.setNormalMap(wallNormalMap);
-        wallModel.setLight(0, directionalLight);
-        wallModel.setLight(1, pointLight);
-        wallModel.setLight(2, spotLight);
         wallModel.setMaterial(defaultMaterial);
         wallModel.setProjectionMatrix(projectionMatrix);
         wallModel.setViewMatrix(viewMatrix);
+        wallModel.setVertexLayout(Engine::VertexLayout::compact());
         wallModel.create();
 
         // -- mobileModel.
         buildMobile();
 
+        for (auto& node : mobileModel) {
+            node.setVertexLayout(Engine::VertexLayout::compact());
+        }
+
         mobileModel[0].setShader(lightingShader);
         mobileModel[0].setTexture(mobileTexture);
         mobileModel[0].setNormalMap(mobileNormalMap);
-        mobileModel[0].setLight(0, directionalLight);
-        mobileModel[0].setLight(1, pointLight);
-        mobileModel[0].setLight(2, spotLight);
         mobileModel[0].setMaterial(defaultMaterial);
         mobileModel[0].setProjectionMatrix(projectionMatrix);
         mobileModel[0].setViewMatrix(viewMatrix);
@@ -147,9 +157,18 @@ public:
         mobileModel[currNodeIndex].setFill(false);
     }
 
+    void onUpdate(float dt) override {
+        movePointLight(dt);
+        rotateSpotLight(dt);
+        mobileModel[0].update(dt);
+    }
+
     void onDraw() override {
-        movePointLight();
-        rotateSpotLight();
+        auto alpha = getInterpolation();
+
+        placeLights(alpha);
+        mobileModel[0].setInterpolation(alpha);
+        lightBuffer.update();
 
         // Draw the models on the FBO.
         fbo.bind();
@@ -167,7 +186,7 @@ public:
     }
 
     void onSizeChange(int width, int height) override {
-        glViewport(0, 0, width, height);
+        Engine::GLState::setViewport(0, 0, width, height);
         fbo.setSize(width, height);
 
         projectionMatrix = glm::perspective(
@@ -360,12 +379,12 @@ private:
 
     void increaseRotationSpeed() {
         std::cout << "Increase the speed of the current node.\n";
-        mobileModel[currNodeIndex].addRotationSpeed(0.001f);
+        mobileModel[currNodeIndex].addRotationSpeed(0.06f);
     }
 
     void decreaseRotationSpeed() {
         std::cout << "Decrease the speed of the current node.\n";
-        mobileModel[currNodeIndex].addRotationSpeed(-0.001f);
+        mobileModel[currNodeIndex].addRotationSpeed(-0.06f);
     }
 
     void resetRotationSpeed() {
@@ -379,37 +398,59 @@ private:
         displayModel.setShader(enableBlur ? blurShader : defaultShader);
     }
 
-    void movePointLight() {
+    // (The speeds are per second.)
+    void movePointLight(float dt) {
         float tau = 3.141592f * 2.0f;
-        pointLightArcsin += 0.007f;
+
+        lastPointLightArcsin = pointLightArcsin;
+        pointLightArcsin += 0.42f * dt;
 
         if (pointLightArcsin > tau) {
             pointLightArcsin -= tau;
+            lastPointLightArcsin -= tau;
         }
-
-        pointLight.position.y = 0.3f + glm::sin(pointLightArcsin);
-
-        wallModel.setLight(1, pointLight);
-        mobileModel[0].setLight(1, pointLight);
     }
 
-    void rotateSpotLight() {
+    void rotateSpotLight(float dt) {
         float tau = 3.141592f * 2.0f;
 
-        spotLightAngle += 0.005f;
+        lastSpotLightAngle = spotLightAngle;
+        spotLightAngle += 0.3f * dt;
 
         if (spotLightAngle > tau) {
             spotLightAngle -= tau;
+            lastSpotLightAngle -= tau;
         }
+    }
+
+    // Place the lights between their last two updates.
+    void placeLights(float alpha) {
+        pointLight.position.y = 0.3f + glm::sin(glm::mix(lastPointLightArcsin, pointLightArcsin, alpha));
 
-        glm::vec3 target{ 0.3f * glm::cos(spotLightAngle), 0.0f, 0.3f * glm::sin(spotLightAngle) };
+        float angle = glm::mix(lastSpotLightAngle, spotLightAngle, alpha);
+        glm::vec3 target{ 0.3f * glm::cos(angle), 0.0f, 0.3f * glm::sin(angle) };
         spotLight.direction = target - spotLight.position;
 
-        wallModel.setLight(2, spotLight);
-        mobileModel[0].setLight(2, spotLight);
+        lightBuffer.setLight(1, pointLight);
+        lightBuffer.setLight(2, spotLight);
     }
 };
 
-int main() {
-    return Scene().run();
+int main(int argc, char* argv[]) {
+    // "--pause": Wait for a key before exiting on an error. (Keeps the console open on Windows.)
+    auto isPausing = argc > 1 && std::string(argv[1]) == "--pause";
+
+    try {
+        return Scene().run();
+    }
+    // (Not only runtime_error: e.g. bad_alloc must not abort without a message either.)
+    catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+
+        if (isPausing) {
+            std::cin.get();
+        }
+
+        return 1;
+    }
 }
@@ -1,20 +1,31 @@
 #version 330 core
 
 uniform mat4 modelMatrix;
-uniform mat4 lightViewMatrix;
-uniform mat4 lightProjectionMatrix;
+// If not 0, the model matrix comes from the instance attributes. (See Engine/InstanceModel.hpp.)
+uniform int isInstanced;
+
+// See Engine/ViewBuffer.hpp.
+layout(std140) uniform ViewBlock {
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 lightViewProjectionMatrix;
+	vec3 cameraPosition;
+};
 
 layout(location = 0) in vec3 vertexPosition_model;
 layout(location = 1) in vec3 vertexNormal_model;
 layout(location = 2) in vec2 vertexTextureUV;
+layout(location = 3) in mat4 instanceMatrix;
 
 out vec3 fragmentPosition_world;
 
 void main() {
-	vec4 vertexPosition_world = modelMatrix * vec4(vertexPosition_model, 1);
+	mat4 matrix = (isInstanced != 0) ? instanceMatrix : modelMatrix;
+	vec4 vertexPosition_world = matrix * vec4(vertexPosition_model, 1);
 
 	// .vert -> GL
-	gl_Position = lightProjectionMatrix * lightViewMatrix * vertexPosition_world;
+	gl_Position = lightViewProjectionMatrix * vertexPosition_world;
 
 	// .vert -> .frag
 	fragmentPosition_world = vertexPosition_world.xyz;
@@ -19,7 +19,7 @@ vec3 calcEdge(vec2 uv) {
     float dx = 0.004;
     float dy = 0.004;
 
-    vec3 a[9] = {
+    vec3 a[9] = vec3[](
         getDepthColor(uv + vec2(-dx, -dy)),
         getDepthColor(uv + vec2(0.0, -dy)),
         getDepthColor(uv + vec2(+dx, -dy)),
@@ -29,7 +29,7 @@ vec3 calcEdge(vec2 uv) {
         getDepthColor(uv + vec2(-dx, +dy)),
         getDepthColor(uv + vec2(0.0, +dy)),
         getDepthColor(uv + vec2(+dx, +dy))
-    };
+    );
 
     vec3 gX = a[2] + 2.0 * a[5] + a[8] - a[0] - 2.0 * a[3] - a[6];
     vec3 gY = a[0] + 2.0 * a[1] + a[2] - a[6] - 2.0 * a[7] - a[8];
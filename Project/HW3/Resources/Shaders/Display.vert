@@ -1,8 +1,7 @@
 #version 330 core
 
+// (Drawn in screen space, so there is no view/projection matrix.)
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat4 projectionMatrix;
 
 layout(location = 0) in vec3 vertexPosition_model;
 layout(location = 1) in vec3 vertexNormal_model;
@@ -26,13 +25,10 @@ mat4 toNormalMatrix(mat4 matrix) {
 
 void main() {
 	vec4 vertexPosition_world = modelMatrix * vec4(vertexPosition_model, 1);
-	vec4 vertexPosition_eye = viewMatrix * vertexPosition_world;
-
 	vec4 vertexNormal_world = toNormalMatrix(modelMatrix) * vec4(vertexNormal_model, 1);
-	vec4 vertexNormal_eye = toNormalMatrix(viewMatrix) * vertexNormal_world;
 
 	// .vert -> GL
-	gl_Position = projectionMatrix * vertexPosition_eye;
+	gl_Position = vertexPosition_world;
 
 	// .vert -> .frag
 	fragmentPosition_world = vertexPosition_world.xyz;
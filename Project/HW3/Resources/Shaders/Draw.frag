@@ -1,29 +1,66 @@
 #version 330 core
 
-uniform struct Light {
-	int type;
+// std140 layout. (See Engine/LightBuffer.hpp.)
+struct Light {
 	vec3 position;
+	int type;
 	vec3 direction;
+	float angle;
 	vec3 ambient;
+	float attenuation;
 	vec3 diffuse;
 	vec3 specular;
-	float angle;
-	float attenuation;
-} lightList[5];
+};
+
+layout(std140) uniform LightBlock {
+	Light lightList[5];
+};
+
+// See Engine/ViewBuffer.hpp.
+layout(std140) uniform ViewBlock {
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 lightViewProjectionMatrix;
+	vec3 cameraPosition;
+};
 
 uniform sampler2D textureUnit;
 uniform sampler2D shadowMapUnit;
 uniform sampler2D brushTextureUnit;
-uniform vec3 cameraPosition;
 uniform int isSelected;
+uniform int isInstanced;
+uniform sampler2D instanceTextureUnitList[4];
 
 in vec3 fragmentPosition_world;
 in vec3 fragmentNormal_world;
 in vec2 fragmentTextureUV;
 in vec3 fragmentShadowUVZ;
+flat in int fragmentTextureIndex;
+flat in int fragmentIsSelected;
 
 layout(location = 0) out vec3 fragmentColor;
 
+// Color of the model's texture. (Instances choose one of instanceTextureUnitList.)
+vec3 sampleTexture() {
+    if (isInstanced == 0) {
+        return texture(textureUnit, fragmentTextureUV).rgb;
+    }
+
+    // (GLSL 3.30 can index the sampler arrays only with constants.)
+    if (fragmentTextureIndex == 1) {
+        return texture(instanceTextureUnitList[1], fragmentTextureUV).rgb;
+    }
+    else if (fragmentTextureIndex == 2) {
+        return texture(instanceTextureUnitList[2], fragmentTextureUV).rgb;
+    }
+    else if (fragmentTextureIndex == 3) {
+        return texture(instanceTextureUnitList[3], fragmentTextureUV).rgb;
+    }
+
+    return texture(instanceTextureUnitList[0], fragmentTextureUV).rgb;
+}
+
 // Direction to the light.
 vec3 toLight(Light light) {
     // Directional light.
@@ -80,7 +117,6 @@ vec3 calcSpecular(Light light) {
 	}
 
 	// Gaussian distribution.
-	vec3 toEye = normalize(cameraPosition - fragmentPosition_world);
 	vec3 halfway = normalize(toLight(light) + toEye());
 	float angle = acos(max(dot(fragmentNormal_world, halfway), 0.0));
 	float smoothness = 0.7;
@@ -108,7 +144,7 @@ vec3 applyBrush(vec3 color) {
 
 vec3 calcCrossHatch(vec3 frontColor, vec3 backColor) {
     float diff = 15.0;
-    float colorNorm = length(texture(textureUnit, fragmentTextureUV).rgb);
+    float colorNorm = length(sampleTexture());
     vec3 resultColor = backColor;
 
     if (colorNorm < 1.00) {
@@ -155,10 +191,10 @@ void main() {
 	}
 
     // (2) Brush effect + Lighting + Shadow map.
-    fragmentColor = applyBrush(texture(textureUnit, fragmentTextureUV).rgb) * intensity * calcShadow();
+    fragmentColor = applyBrush(sampleTexture()) * intensity * calcShadow();
 
     // (3) If we selected the current model, apply cross hatching.
-	if (isSelected != 0) {
+	if ((isInstanced != 0 ? fragmentIsSelected : isSelected) != 0) {
 	    fragmentColor = calcCrossHatch(fragmentColor, vec3(1.0, 1.0, 1.0));
 	}
 }
@@ -1,19 +1,30 @@
 #version 330 core
 
 uniform mat4 modelMatrix;
-uniform mat4 viewMatrix;
-uniform mat4 projectionMatrix;
-uniform mat4 lightViewMatrix;
-uniform mat4 lightProjectionMatrix;
+// If not 0, the model matrix comes from the instance attributes. (See Engine/InstanceModel.hpp.)
+uniform int isInstanced;
+
+// See Engine/ViewBuffer.hpp.
+layout(std140) uniform ViewBlock {
+	mat4 viewMatrix;
+	mat4 projectionMatrix;
+	mat4 viewProjectionMatrix;
+	mat4 lightViewProjectionMatrix;
+	vec3 cameraPosition;
+};
 
 layout(location = 0) in vec3 vertexPosition_model;
 layout(location = 1) in vec3 vertexNormal_model;
 layout(location = 2) in vec2 vertexTextureUV;
+layout(location = 3) in mat4 instanceMatrix;
+layout(location = 7) in ivec2 instanceData; // (Texture index, Selection flag)
 
 out vec3 fragmentPosition_world;
 out vec3 fragmentNormal_world;
 out vec2 fragmentTextureUV;
 out vec3 fragmentShadowUVZ;
+flat out int fragmentTextureIndex;
+flat out int fragmentIsSelected;
 
 // Calculate the "normal vector" version of the matrix.
 // (i.e transpose(inverse(matrix)))
@@ -36,18 +47,18 @@ void main() {
         0.5, 0.5, 0.5, 1.0
     );
 
-	vec4 vertexPosition_world = modelMatrix * vec4(vertexPosition_model, 1);
-	vec4 vertexPosition_eye = viewMatrix * vertexPosition_world;
-
-	vec4 vertexNormal_world = toNormalMatrix(modelMatrix) * vec4(vertexNormal_model, 1);
-	vec4 vertexNormal_eye = toNormalMatrix(viewMatrix) * vertexNormal_world;
+	mat4 matrix = (isInstanced != 0) ? instanceMatrix : modelMatrix;
+	vec4 vertexPosition_world = matrix * vec4(vertexPosition_model, 1);
+	vec4 vertexNormal_world = toNormalMatrix(matrix) * vec4(vertexNormal_model, 1);
 
 	// .vert -> GL
-	gl_Position = projectionMatrix * vertexPosition_eye;
+	gl_Position = viewProjectionMatrix * vertexPosition_world;
 
 	// .vert -> .frag
 	fragmentPosition_world = vertexPosition_world.xyz;
 	fragmentNormal_world = vertexNormal_world.xyz;
 	fragmentTextureUV = vertexTextureUV;
-	fragmentShadowUVZ = (biasMatrix * lightProjectionMatrix * lightViewMatrix * vertexPosition_world).xyz;
+	fragmentShadowUVZ = (biasMatrix * lightViewProjectionMatrix * vertexPosition_world).xyz;
+	fragmentTextureIndex = (isInstanced != 0) ? instanceData.x : 0;
+	fragmentIsSelected = (isInstanced != 0) ? instanceData.y : 0;
 }
@@ -1,5 +1,8 @@
 #include "App.hpp"
 
+static const Engine::UniformHandle<GLint> DEPTH_MAP_UNIT{"depthMapUnit"}; // NOLINT
+static const Engine::UniformHandle<GLint> RESOLUTION{"resolution"}; // NOLINT
+
 namespace App {
     DisplayModel::DisplayModel(float size) {
         std::vector<glm::vec2> xyList{
@@ -50,7 +53,7 @@ namespace App {
             throw std::runtime_error("Error: Depth map is not set.");
         }
 
-        m_program->setUniform("depthMapUnit", m_depthMap->getUnit());
-        m_program->setUniform("resolution", m_resolution);
+        m_program->setUniform(DEPTH_MAP_UNIT, m_depthMap->getUnit());
+        m_program->setUniform(RESOLUTION, m_resolution);
     }
 }
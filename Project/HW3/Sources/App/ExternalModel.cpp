@@ -1,5 +1,6 @@
 #include "App.hpp"
 
 namespace App {
-    ExternalModel::ExternalModel(const std::string &path) : Engine::OBJModel<GeneralModel>(path) {}
+    ExternalModel::ExternalModel(const std::string &path, int threadCount, const Engine::VertexLayout &layout) :
+            Engine::OBJModel<GeneralModel>(path, threadCount, layout) {}
 }
@@ -6,8 +6,17 @@
 namespace App {
     class ExternalModel : public Engine::OBJModel<GeneralModel> {
     public:
-        explicit ExternalModel(const std::string &path);
+        // threadCount: Threads for parsing the file. (See Engine::OBJParser.)
+        // layout: Format of the vertices in the VBO. (See Engine::VertexLayout.)
+        explicit ExternalModel(
+                const std::string &path,
+                int threadCount = Engine::OBJParser::SINGLE_THREAD,
+                const Engine::VertexLayout &layout = Engine::VertexLayout()
+        );
     };
+
+    // Copies of an .obj model, drawn with one instanced draw call. (See Engine::InstanceModel.)
+    using InstancedExternalModel = Engine::InstanceModel<ExternalModel>;
 }
 
 #endif
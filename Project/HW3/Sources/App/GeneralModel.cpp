@@ -1,5 +1,8 @@
 #include "App.hpp"
 
+static const Engine::UniformHandle<GLint> BRUSH_TEXTURE_UNIT{"brushTextureUnit"}; // NOLINT
+static const Engine::UniformHandle<GLint> IS_SELECTED{"isSelected"}; // NOLINT
+
 namespace App {
     void GeneralModel::select(bool isSelected) {
         m_isSelected = isSelected;
@@ -16,7 +19,7 @@ namespace App {
             throw std::runtime_error("Error: Brush texture is not set.");
         }
 
-        m_program->setUniform("brushTextureUnit", m_brushTexture->getUnit());
-        m_program->setUniform("isSelected", m_isSelected);
+        m_program->setUniform(BRUSH_TEXTURE_UNIT, m_brushTexture->getUnit());
+        m_program->setUniform(IS_SELECTED, m_isSelected);
     }
 }
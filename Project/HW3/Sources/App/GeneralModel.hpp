@@ -4,7 +4,7 @@
 #include "App.hpp"
 
 namespace App {
-    using GeneralBaseModel = Engine::LightModel<Engine::ShadowModel<Engine::TextureModel<Engine::Model>>>;
+    using GeneralBaseModel = Engine::ShadowModel<Engine::TextureModel<Engine::Model>>;
 
     class GeneralModel : public GeneralBaseModel {
     public:
@@ -13,9 +13,10 @@ namespace App {
 
         void setBrushTexture(Engine::Texture *texture);
 
-    private:
+    protected:
         void onDraw() override;
 
+    private:
         Engine::Texture *m_brushTexture = nullptr;
 
         GLint m_isSelected = false;
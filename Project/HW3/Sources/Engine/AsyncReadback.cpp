@@ -0,0 +1,151 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    AsyncReadback::AsyncReadback(int bufferCount) :
+            m_slotList(static_cast<size_t>(std::max(bufferCount, 1))) {
+        for (auto &slot: m_slotList) {
+            glGenBuffers(1, &slot.bufferId);
+            slot.capacity = 0;
+            slot.fence = nullptr;
+        }
+    }
+
+    AsyncReadback::~AsyncReadback() {
+        // Nothing to free if the context is already gone.
+        if (!Backend::isContextCurrent()) {
+            return;
+        }
+
+        for (auto &slot: m_slotList) {
+            if (slot.fence != nullptr) {
+                glDeleteSync(slot.fence);
+            }
+
+            glDeleteBuffers(1, &slot.bufferId);
+        }
+    }
+
+    void AsyncReadback::request(
+            const FrameBuffer *frameBuffer,
+            Source source,
+            GLint x,
+            GLint y,
+            GLsizei width,
+            GLsizei height,
+            const Callback &callback
+    ) {
+        // All the buffers are in flight: Wait for the oldest one.
+        if (m_pendingCount == static_cast<int>(m_slotList.size())) {
+            m_stallCount++;
+            deliver();
+        }
+
+        auto &slot = m_slotList[(m_head + m_pendingCount) % m_slotList.size()];
+        auto pixelSize = source == COLOR ? 4 : static_cast<GLsizeiptr>(sizeof(GLfloat));
+        auto size = static_cast<GLsizeiptr>(width) * height * pixelSize;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId);
+
+        if (size > slot.capacity) {
+            glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+            slot.capacity = size;
+        }
+
+        // With a pack buffer bound, glReadPixels only queues the copy and returns.
+        GLState::bindReadFramebuffer(frameBuffer != nullptr ? frameBuffer->getId() : 0);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+        if (source == COLOR) {
+            glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        }
+        else {
+            glReadPixels(x, y, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.result.source = source;
+        slot.result.x = x;
+        slot.result.y = y;
+        slot.result.width = width;
+        slot.result.height = height;
+        slot.callback = callback;
+
+        m_pendingCount++;
+    }
+
+    int AsyncReadback::poll() {
+        int count = 0;
+
+        // In order: Stop at the first read which is not done yet.
+        while (m_pendingCount > 0) {
+            auto status = glClientWaitSync(m_slotList[m_head].fence, 0, 0);
+
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                break;
+            }
+
+            deliver();
+            count++;
+        }
+
+        return count;
+    }
+
+    void AsyncReadback::finish() {
+        while (m_pendingCount > 0) {
+            deliver();
+        }
+    }
+
+    int AsyncReadback::getPendingCount() const {
+        return m_pendingCount;
+    }
+
+    unsigned int AsyncReadback::getStallCount() const {
+        return m_stallCount;
+    }
+
+    void AsyncReadback::deliver() {
+        auto &slot = m_slotList[m_head];
+
+        // (Returns at once if the fence passed already. The flush makes sure it's ever signaled.)
+        GLenum status;
+
+        do {
+            status = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+
+        glDeleteSync(slot.fence);
+        slot.fence = nullptr;
+
+        auto pixelSize = slot.result.source == COLOR ? 4 : static_cast<GLsizeiptr>(sizeof(GLfloat));
+        auto size = static_cast<GLsizeiptr>(slot.result.width) * slot.result.height * pixelSize;
+
+        slot.result.data.resize(static_cast<size_t>(size));
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.bufferId);
+
+        auto data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+
+        if (data != nullptr) {
+            std::memcpy(slot.result.data.data(), data, static_cast<size_t>(size));
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        // Free the slot before the callback, so the callback can request again.
+        auto result = std::move(slot.result);
+        auto callback = std::move(slot.callback);
+
+        slot.callback = nullptr;
+        m_head = static_cast<int>((m_head + 1) % m_slotList.size());
+        m_pendingCount--;
+
+        if (data != nullptr && callback) {
+            callback(result);
+        }
+    }
+}
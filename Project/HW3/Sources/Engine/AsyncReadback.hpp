@@ -0,0 +1,81 @@
+#ifndef ENGINE_ASYNC_READBACK_HPP
+#define ENGINE_ASYNC_READBACK_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Reads pixels back without stalling the pipeline.
+    // request() copies the pixels into a pixel pack buffer of a ring and puts a fence after it.
+    // poll() (once per frame) delivers the reads whose fences passed, usually 1 ~ 2 frames later, in order.
+    //
+    // If all the buffers are still in flight, request() waits for the oldest one. (See getStallCount().)
+    class AsyncReadback {
+    public:
+        enum Source {
+            COLOR, // RGBA, 1 byte per channel
+            DEPTH // 1 float per pixel
+        };
+
+        struct Result {
+            Source source;
+            GLint x;
+            GLint y;
+            GLsizei width;
+            GLsizei height;
+            // Rows from the bottom, as GL returns them.
+            std::vector<uint8_t> data;
+        };
+
+        using Callback = std::function<void(const Result &)>;
+
+        explicit AsyncReadback(int bufferCount = 3);
+        ~AsyncReadback();
+
+        AsyncReadback(const AsyncReadback &) = delete;
+        AsyncReadback &operator=(const AsyncReadback &) = delete;
+
+        // Start reading the rectangle of the frame buffer. (nullptr: The default frame buffer)
+        void request(
+                const FrameBuffer *frameBuffer,
+                Source source,
+                GLint x,
+                GLint y,
+                GLsizei width,
+                GLsizei height,
+                const Callback &callback
+        );
+
+        // Deliver the finished reads. Returns the number of them.
+        int poll();
+
+        // Wait for all the reads and deliver them. (Stalls. For shutting down or tests.)
+        void finish();
+
+        // Number of the reads in flight.
+        int getPendingCount() const;
+
+        // Number of the times request() had to wait for a buffer.
+        unsigned int getStallCount() const;
+
+    private:
+        struct Slot {
+            GLuint bufferId;
+            GLsizeiptr capacity;
+            GLsync fence;
+            Result result;
+            Callback callback;
+        };
+
+        // Map the buffer of the oldest slot, deliver it and free the slot.
+        void deliver();
+
+        std::vector<Slot> m_slotList;
+        // Oldest slot in flight, and the number of the slots in flight.
+        int m_head = 0;
+        int m_pendingCount = 0;
+
+        unsigned int m_stallCount = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,21 @@
+#include "Engine.hpp"
+
+// Set by the backends when they create & destroy their contexts.
+static bool isContextAlive = false;
+
+namespace Engine {
+    GLFWwindow *Backend::getWindow() const {
+        return nullptr;
+    }
+
+    void Backend::setSwapInterval(int /* interval */) {
+    }
+
+    bool Backend::isContextCurrent() {
+        return isContextAlive;
+    }
+
+    void Backend::setContextCurrent(bool isCurrent) {
+        isContextAlive = isCurrent;
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef ENGINE_BACKEND_HPP
+#define ENGINE_BACKEND_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Owner of the OpenGL context and of the default frame buffer. (See WindowBackend, OffscreenBackend.)
+    // The backend initializes GLEW after making its context current.
+    class Backend {
+    public:
+        enum Type {
+            WINDOW, // GLFW window
+            OFFSCREEN // EGL pbuffer. (No display needed. Build with ENGINE_USE_EGL.)
+        };
+
+        virtual ~Backend() = default;
+
+        // Show the finished frame and handle the events.
+        virtual void present() = 0;
+
+        // True if the user asked to quit. (Never for the offscreen backend.)
+        virtual bool isClosed() const = 0;
+
+        virtual void getFrameBufferSize(int &width, int &height) const = 0;
+
+        // GLFW window. (nullptr for the offscreen backend.)
+        virtual GLFWwindow *getWindow() const;
+
+        // Number of the vertical blanks to wait for in present(). (0: Don't wait. No effect offscreen.)
+        virtual void setSwapInterval(int interval);
+
+        // Is there a live context? (Destructors of the GL objects check this before deleting them.)
+        static bool isContextCurrent();
+
+    protected:
+        static void setContextCurrent(bool isCurrent);
+    };
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    Bounds Bounds::fromPoints(const glm::vec3 *data, size_t count) {
+        if (count == 0) {
+            return Bounds();
+        }
+
+        glm::vec3 min = data[0];
+        glm::vec3 max = data[0];
+
+        for (size_t i = 1; i < count; i++) {
+            min = glm::min(min, data[i]);
+            max = glm::max(max, data[i]);
+        }
+
+        auto bounds = fromBox(min, max);
+
+        // The farthest point from the box center. (Tighter than the half diagonal.)
+        float radiusSquared = 0.0f;
+
+        for (size_t i = 0; i < count; i++) {
+            auto offset = data[i] - bounds.center;
+
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+
+        bounds.radius = std::sqrt(radiusSquared);
+
+        return bounds;
+    }
+
+    Bounds Bounds::fromBox(const glm::vec3 &min, const glm::vec3 &max) {
+        Bounds bounds;
+
+        bounds.min = min;
+        bounds.max = max;
+        bounds.center = (min + max) * 0.5f;
+        bounds.radius = glm::length(max - min) * 0.5f;
+        bounds.isEmpty = false;
+
+        return bounds;
+    }
+
+    Bounds Bounds::transform(const glm::mat4 &matrix) const {
+        if (isEmpty) {
+            return *this;
+        }
+
+        // Start from the translation and add the extent of each column. (Arvo's method)
+        glm::vec3 newMin{matrix[3]};
+        glm::vec3 newMax{matrix[3]};
+
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                auto a = matrix[column][row] * min[column];
+                auto b = matrix[column][row] * max[column];
+
+                newMin[row] += std::min(a, b);
+                newMax[row] += std::max(a, b);
+            }
+        }
+
+        auto bounds = fromBox(newMin, newMax);
+
+        // The sphere moves with the matrix and grows with its largest scale. Keep it if it's tighter.
+        auto scale = std::max(
+                glm::length(glm::vec3(matrix[0])),
+                std::max(glm::length(glm::vec3(matrix[1])), glm::length(glm::vec3(matrix[2])))
+        );
+
+        if (radius * scale < bounds.radius) {
+            bounds.center = glm::vec3(matrix * glm::vec4(center, 1.0f));
+            bounds.radius = radius * scale;
+        }
+
+        return bounds;
+    }
+
+    Bounds Bounds::merge(const Bounds &other) const {
+        if (isEmpty) {
+            return other;
+        }
+
+        if (other.isEmpty) {
+            return *this;
+        }
+
+        return fromBox(glm::min(min, other.min), glm::max(max, other.max));
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef ENGINE_BOUNDS_HPP
+#define ENGINE_BOUNDS_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Extent of a mesh: An axis-aligned box and a sphere around it.
+    // Empty bounds (no points yet) are never culled.
+    struct Bounds {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+        bool isEmpty = true;
+
+        // Bounds of the points.
+        static Bounds fromPoints(const glm::vec3 *data, size_t count);
+
+        // Bounds of the box.
+        static Bounds fromBox(const glm::vec3 &min, const glm::vec3 &max);
+
+        // Bounds of the transformed box. (Still axis-aligned, so it can be larger than the exact one.)
+        Bounds transform(const glm::mat4 &matrix) const;
+
+        // Bounds containing both.
+        Bounds merge(const Bounds &other) const;
+    };
+}
+
+#endif
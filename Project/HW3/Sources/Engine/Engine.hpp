@@ -3,13 +3,30 @@
 
 // Standard.
 #include <cstdlib>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
 #include <iostream>
 #include <fstream>
 #include <sstream>
+#include <iomanip>
 #include <memory>
 #include <string>
 #include <vector>
 #include <map>
+#include <utility>
+#include <deque>
+#include <functional>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <iterator>
 #include <algorithm>
 #include <initializer_list>
 
@@ -32,20 +49,50 @@
 #include <SOIL/SOIL.h>
 
 // Engine.
+#include "Hash.hpp"
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+#include "MappedFile.hpp"
+#include "GLState.hpp"
+#include "TripleBuffer.hpp"
+
+#include "Backend.hpp"
+#include "WindowBackend.hpp"
+#include "OffscreenBackend.hpp"
+#include "Profiler.hpp"
 #include "Renderer.hpp"
 
+#include "TextureCache.hpp"
 #include "Texture.hpp"
+#include "TextureLoader.hpp"
 #include "FrameBuffer.hpp"
+#include "AsyncReadback.hpp"
 
 #include "Shader.hpp"
+#include "ProgramCache.hpp"
 #include "Program.hpp"
+#include "UniformHandle.hpp"
+
+#include "UniformBuffer.hpp"
 
 #include "Light.hpp"
+#include "LightBuffer.hpp"
+#include "ViewBuffer.hpp"
+
+#include "VertexWelder.hpp"
+#include "OBJParser.hpp"
+#include "MeshCache.hpp"
+#include "VertexLayout.hpp"
+#include "Mesh.hpp"
+#include "MeshRegistry.hpp"
 
 #include "Model.hpp"
 #include "TextureModel.hpp"
 #include "ShadowModel.hpp"
-#include "LightModel.hpp"
 #include "OBJModel.hpp"
+#include "InstanceModel.hpp"
+
+#include "SceneTree.hpp"
+#include "RenderQueue.hpp"
 
 #endif
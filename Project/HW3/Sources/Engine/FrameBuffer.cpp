@@ -8,7 +8,7 @@ namespace Engine {
             m_depthTexture(width, height, {nullptr}, GL_DEPTH_COMPONENT16, GL_DEPTH_COMPONENT, false) {
         // Create a frame buffer.
         glGenFramebuffers(1, &m_frameBufferId);
-        glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferId);
+        GLState::bindFramebuffer(m_frameBufferId);
 
         // Attach the depth buffer.
         glGenRenderbuffers(1, &m_renderBufferId);
@@ -43,17 +43,29 @@ namespace Engine {
             throw std::runtime_error("Error: Failed to generate a new frame buffer.");
         }
 
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        GLState::bindFramebuffer(0);
     }
 
     void FrameBuffer::bind() const {
-        glBindFramebuffer(GL_FRAMEBUFFER, m_frameBufferId);
-        glViewport(0, 0, m_width, m_height);
+        GLState::bindFramebuffer(m_frameBufferId);
+        GLState::setViewport(0, 0, m_width, m_height);
     }
 
     void FrameBuffer::unbind() const {
-        glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        glViewport(0, 0, m_width, m_height);
+        GLState::bindFramebuffer(0);
+        GLState::setViewport(0, 0, m_width, m_height);
+    }
+
+    GLuint FrameBuffer::getId() const {
+        return m_frameBufferId;
+    }
+
+    GLsizei FrameBuffer::getWidth() const {
+        return m_width;
+    }
+
+    GLsizei FrameBuffer::getHeight() const {
+        return m_height;
     }
 
     Texture *FrameBuffer::getColorTexture() {
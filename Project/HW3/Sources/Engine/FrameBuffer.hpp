@@ -13,6 +13,10 @@ namespace Engine {
         void bind() const;
         void unbind() const;
 
+        GLuint getId() const;
+        GLsizei getWidth() const;
+        GLsizei getHeight() const;
+
         Texture *getColorTexture();
         Texture *getDepthTexture();
 
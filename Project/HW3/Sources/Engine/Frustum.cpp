@@ -0,0 +1,114 @@
+#include "Engine.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ENGINE_FRUSTUM_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Engine {
+    Frustum::Frustum(const glm::mat4 &viewProjectionMatrix) {
+        // Rows of the matrix. (Gribb & Hartmann)
+        auto &m = viewProjectionMatrix;
+        glm::vec4 rowList[4];
+
+        for (int row = 0; row < 4; row++) {
+            rowList[row] = glm::vec4(m[0][row], m[1][row], m[2][row], m[3][row]);
+        }
+
+        glm::vec4 planeList[6] = {
+                rowList[3] + rowList[0], // Left
+                rowList[3] - rowList[0], // Right
+                rowList[3] + rowList[1], // Bottom
+                rowList[3] - rowList[1], // Top
+                rowList[3] + rowList[2], // Near
+                rowList[3] - rowList[2]  // Far
+        };
+
+        for (int i = 0; i < 6; i++) {
+            // Normalize, so that the distances can be compared with the radii.
+            auto length = glm::length(glm::vec3(planeList[i]));
+            auto plane = length > 0.0f ? planeList[i] / length : planeList[i];
+
+            m_xList[i] = plane.x;
+            m_yList[i] = plane.y;
+            m_zList[i] = plane.z;
+            m_wList[i] = plane.w;
+        }
+    }
+
+    void Frustum::testSpheres(const glm::vec4 *sphereList, size_t count, uint8_t *visibleList) const {
+        size_t i = 0;
+
+#ifdef ENGINE_FRUSTUM_SSE
+        // 4 spheres per iteration: Transpose them to (x, x, x, x), (y, ...), ... and test against each plane.
+        for (; i + 4 <= count; i += 4) {
+            auto x = _mm_loadu_ps(&sphereList[i].x);
+            auto y = _mm_loadu_ps(&sphereList[i + 1].x);
+            auto z = _mm_loadu_ps(&sphereList[i + 2].x);
+            auto r = _mm_loadu_ps(&sphereList[i + 3].x);
+
+            _MM_TRANSPOSE4_PS(x, y, z, r);
+
+            auto negativeR = _mm_sub_ps(_mm_setzero_ps(), r);
+            auto outside = _mm_setzero_ps();
+
+            for (int plane = 0; plane < 6; plane++) {
+                auto distance = _mm_add_ps(
+                        _mm_add_ps(
+                                _mm_mul_ps(x, _mm_set1_ps(m_xList[plane])),
+                                _mm_mul_ps(y, _mm_set1_ps(m_yList[plane]))
+                        ),
+                        _mm_add_ps(
+                                _mm_mul_ps(z, _mm_set1_ps(m_zList[plane])),
+                                _mm_set1_ps(m_wList[plane])
+                        )
+                );
+
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeR));
+            }
+
+            auto mask = _mm_movemask_ps(outside);
+
+            for (int lane = 0; lane < 4; lane++) {
+                visibleList[i + lane] = static_cast<uint8_t>(((mask >> lane) & 1) == 0 ? 1 : 0);
+            }
+        }
+#endif
+
+        // The rest. (Or all of them without SSE.)
+        for (; i < count; i++) {
+            auto &sphere = sphereList[i];
+            uint8_t isVisible = 1;
+
+            for (int plane = 0; plane < 6; plane++) {
+                auto distance = m_xList[plane] * sphere.x
+                                + m_yList[plane] * sphere.y
+                                + m_zList[plane] * sphere.z
+                                + m_wList[plane];
+
+                if (distance < -sphere.w) {
+                    isVisible = 0;
+                    break;
+                }
+            }
+
+            visibleList[i] = isVisible;
+        }
+    }
+
+    bool Frustum::testBox(const glm::vec3 &min, const glm::vec3 &max) const {
+        for (int plane = 0; plane < 6; plane++) {
+            // The corner farthest along the plane normal. If even this one is outside, the whole box is.
+            auto distance = m_xList[plane] * (m_xList[plane] >= 0.0f ? max.x : min.x)
+                            + m_yList[plane] * (m_yList[plane] >= 0.0f ? max.y : min.y)
+                            + m_zList[plane] * (m_zList[plane] >= 0.0f ? max.z : min.z)
+                            + m_wList[plane];
+
+            if (distance < 0.0f) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef ENGINE_FRUSTUM_HPP
+#define ENGINE_FRUSTUM_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Six planes of a view volume, for culling the models outside of it.
+    // The planes point inwards. (A point p is inside if dot(plane.xyz, p) + plane.w >= 0 for all planes.)
+    class Frustum {
+    public:
+        Frustum() = default;
+
+        // Extract the planes from a (projection * view) matrix. (Works for both perspective and orthographic.)
+        explicit Frustum(const glm::mat4 &viewProjectionMatrix);
+
+        // Test the spheres (xyz: Center, w: Radius) 4 at a time, and write 1 into visibleList
+        // for the ones which touch the volume and 0 for the others.
+        void testSpheres(const glm::vec4 *sphereList, size_t count, uint8_t *visibleList) const;
+
+        // Exact test of an axis-aligned box. (For the spheres which passed.)
+        bool testBox(const glm::vec3 &min, const glm::vec3 &max) const;
+
+    private:
+        // Planes in SoA order, so a batch test loads one component of all the planes at once.
+        float m_xList[6] = {0.0f};
+        float m_yList[6] = {0.0f};
+        float m_zList[6] = {0.0f};
+        float m_wList[6] = {0.0f};
+    };
+}
+
+#endif
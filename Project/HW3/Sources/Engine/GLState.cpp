@@ -0,0 +1,229 @@
+#include "Engine.hpp"
+
+// Maximum number of the texture units we track. (Units above it are always bound.)
+static const int MAX_UNITS = 32;
+// Value which never matches a real state.
+static const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+// Currently bound objects & states. (Starts with UNKNOWN everywhere.)
+struct StateCache {
+    StateCache() {
+        reset();
+    }
+
+    void reset();
+
+    GLuint programId;
+    GLuint vertexArrayId;
+    GLuint activeUnit;
+    GLuint texture2DIdList[MAX_UNITS];
+    GLuint textureCubeIdList[MAX_UNITS];
+    GLuint framebufferId;
+    GLuint polygonMode;
+    GLuint isCullEnabled;
+    GLuint cullFace;
+    GLuint isDepthEnabled;
+    GLuint depthFunction;
+    GLint viewport[4];
+};
+
+static StateCache cache;
+static Engine::GLState::Counters currCounters;
+static Engine::GLState::Counters lastCounters;
+
+static void resetCounters(Engine::GLState::Counters &counters);
+
+// Returns true if the value changed. (Also counts the call.)
+static bool update(Engine::GLState::Kind kind, GLuint &cachedValue, GLuint value);
+
+namespace Engine {
+    unsigned int GLState::Counters::getIssued() const {
+        unsigned int sum = 0;
+
+        for (auto count: issuedList) {
+            sum += count;
+        }
+
+        return sum;
+    }
+
+    unsigned int GLState::Counters::getElided() const {
+        unsigned int sum = 0;
+
+        for (auto count: elidedList) {
+            sum += count;
+        }
+
+        return sum;
+    }
+
+    void GLState::useProgram(GLuint id) {
+        if (update(PROGRAM, cache.programId, id)) {
+            glUseProgram(id);
+        }
+    }
+
+    void GLState::bindVertexArray(GLuint id) {
+        if (update(VERTEX_ARRAY, cache.vertexArrayId, id)) {
+            glBindVertexArray(id);
+        }
+    }
+
+    void GLState::bindTexture(GLint unit, GLenum target, GLuint id) {
+        GLuint *cachedId = nullptr;
+
+        if (unit >= 0 && unit < MAX_UNITS) {
+            if (target == GL_TEXTURE_2D) {
+                cachedId = &cache.texture2DIdList[unit];
+            }
+            else if (target == GL_TEXTURE_CUBE_MAP) {
+                cachedId = &cache.textureCubeIdList[unit];
+            }
+        }
+
+        GLuint untracked = UNKNOWN;
+
+        if (!update(TEXTURE, (cachedId != nullptr ? *cachedId : untracked), id)) {
+            return;
+        }
+
+        // (Selecting the unit is a part of the bind, so it is not counted separately.)
+        if (cache.activeUnit != static_cast<GLuint>(unit)) {
+            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+            cache.activeUnit = static_cast<GLuint>(unit);
+        }
+
+        glBindTexture(target, id);
+    }
+
+    void GLState::selectTexture(GLint unit, GLenum target, GLuint id) {
+        if (cache.activeUnit != static_cast<GLuint>(unit)) {
+            glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + unit));
+            cache.activeUnit = static_cast<GLuint>(unit);
+        }
+
+        bindTexture(unit, target, id);
+    }
+
+    void GLState::bindFramebuffer(GLuint id) {
+        if (update(FRAMEBUFFER, cache.framebufferId, id)) {
+            glBindFramebuffer(GL_FRAMEBUFFER, id);
+        }
+    }
+
+    void GLState::bindReadFramebuffer(GLuint id) {
+        // (The cache holds one id for both targets, which is no longer true after this.)
+        currCounters.issuedList[FRAMEBUFFER]++;
+        cache.framebufferId = UNKNOWN;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, id);
+    }
+
+    void GLState::setPolygonMode(GLenum mode) {
+        if (update(POLYGON_MODE, cache.polygonMode, mode)) {
+            glPolygonMode(GL_FRONT_AND_BACK, mode);
+        }
+    }
+
+    void GLState::setCullFace(bool isEnabled, GLenum face) {
+        if (update(CULL_FACE, cache.isCullEnabled, isEnabled ? 1u : 0u)) {
+            if (isEnabled) {
+                glEnable(GL_CULL_FACE);
+            }
+            else {
+                glDisable(GL_CULL_FACE);
+            }
+        }
+
+        if (isEnabled && update(CULL_FACE, cache.cullFace, face)) {
+            glCullFace(face);
+        }
+    }
+
+    void GLState::setDepthTest(bool isEnabled, GLenum function) {
+        if (update(DEPTH_TEST, cache.isDepthEnabled, isEnabled ? 1u : 0u)) {
+            if (isEnabled) {
+                glEnable(GL_DEPTH_TEST);
+            }
+            else {
+                glDisable(GL_DEPTH_TEST);
+            }
+        }
+
+        if (isEnabled && update(DEPTH_TEST, cache.depthFunction, function)) {
+            glDepthFunc(function);
+        }
+    }
+
+    void GLState::setViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        GLint viewport[4] = {x, y, width, height};
+
+        if (std::memcmp(cache.viewport, viewport, sizeof(viewport)) == 0) {
+            currCounters.elidedList[VIEWPORT]++;
+            return;
+        }
+
+        currCounters.issuedList[VIEWPORT]++;
+        std::memcpy(cache.viewport, viewport, sizeof(viewport));
+        glViewport(x, y, width, height);
+    }
+
+    void GLState::releaseVertexArray(GLuint id) {
+        if (cache.vertexArrayId == id) {
+            cache.vertexArrayId = 0;
+        }
+    }
+
+    void GLState::invalidate() {
+        cache.reset();
+    }
+
+    void GLState::beginFrame() {
+        lastCounters = currCounters;
+        resetCounters(currCounters);
+    }
+
+    const GLState::Counters &GLState::getFrameCounters() {
+        return lastCounters;
+    }
+}
+
+void StateCache::reset() {
+    programId = UNKNOWN;
+    vertexArrayId = UNKNOWN;
+    activeUnit = UNKNOWN;
+
+    for (int i = 0; i < MAX_UNITS; i++) {
+        texture2DIdList[i] = UNKNOWN;
+        textureCubeIdList[i] = UNKNOWN;
+    }
+
+    framebufferId = UNKNOWN;
+    polygonMode = UNKNOWN;
+    isCullEnabled = UNKNOWN;
+    cullFace = UNKNOWN;
+    isDepthEnabled = UNKNOWN;
+    depthFunction = UNKNOWN;
+
+    for (auto &value: viewport) {
+        value = -1;
+    }
+}
+
+static void resetCounters(Engine::GLState::Counters &counters) {
+    for (int i = 0; i < Engine::GLState::KIND_COUNT; i++) {
+        counters.issuedList[i] = 0;
+        counters.elidedList[i] = 0;
+    }
+}
+
+static bool update(Engine::GLState::Kind kind, GLuint &cachedValue, GLuint value) {
+    // (UNKNOWN is used for the untracked states, so they are always issued.)
+    if (cachedValue == value && value != UNKNOWN) {
+        currCounters.elidedList[kind]++;
+        return false;
+    }
+
+    currCounters.issuedList[kind]++;
+    cachedValue = value;
+    return true;
+}
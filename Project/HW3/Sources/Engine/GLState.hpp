@@ -0,0 +1,62 @@
+#ifndef ENGINE_GL_STATE_HPP
+#define ENGINE_GL_STATE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Cache of the OpenGL state. The binds and the state changes go through here, and the calls
+    // which wouldn't change anything are skipped. (Don't change the same state with raw GL calls,
+    // or call invalidate() after doing so.)
+    class GLState {
+    public:
+        enum Kind {
+            PROGRAM = 0,
+            VERTEX_ARRAY,
+            TEXTURE,
+            FRAMEBUFFER,
+            POLYGON_MODE,
+            CULL_FACE,
+            DEPTH_TEST,
+            VIEWPORT,
+            KIND_COUNT
+        };
+
+        // Number of the calls in a frame.
+        struct Counters {
+            unsigned int issuedList[KIND_COUNT];
+            unsigned int elidedList[KIND_COUNT];
+
+            unsigned int getIssued() const;
+            unsigned int getElided() const;
+        };
+
+        static void useProgram(GLuint id);
+        static void bindVertexArray(GLuint id);
+        // (Also selects the texture unit.)
+        static void bindTexture(GLint unit, GLenum target, GLuint id);
+        // Bind the texture, and leave its unit selected so that it can be edited.
+        // (bindTexture() doesn't select the unit if the texture is bound already.)
+        static void selectTexture(GLint unit, GLenum target, GLuint id);
+        static void bindFramebuffer(GLuint id);
+        // Bind only the read target. (The next bindFramebuffer() is always issued.)
+        static void bindReadFramebuffer(GLuint id);
+        static void setPolygonMode(GLenum mode);
+        static void setCullFace(bool isEnabled, GLenum face = GL_BACK);
+        static void setDepthTest(bool isEnabled, GLenum function = GL_LESS);
+        static void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        // Forget the cached binding if the object is deleted. (GL unbinds it, too.)
+        static void releaseVertexArray(GLuint id);
+
+        // Forget everything. (The next calls are always issued.)
+        static void invalidate();
+
+        // Start a new frame. (The counters of the previous frame are kept for getFrameCounters().)
+        static void beginFrame();
+
+        // Counters of the last finished frame.
+        static const Counters &getFrameCounters();
+    };
+}
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef ENGINE_HASH_HPP
+#define ENGINE_HASH_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // 64-bit FNV-1a. Pass the previous result as 'seed' to hash several pieces as one.
+    inline uint64_t hashBytes(const void *data, size_t size, uint64_t seed = 14695981039346656037ULL) {
+        auto bytes = static_cast<const unsigned char *>(data);
+        uint64_t hash = seed;
+
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+
+        return hash;
+    }
+
+    inline uint64_t hashString(const std::string &value, uint64_t seed = 14695981039346656037ULL) {
+        return hashBytes(value.data(), value.size(), seed);
+    }
+}
+
+#endif
@@ -0,0 +1,237 @@
+#ifndef ENGINE_INSTANCE_MODEL_HPP
+#define ENGINE_INSTANCE_MODEL_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Mixin for drawing many copies of the mesh with one instanced draw call.
+    // Each instance has its own model matrix, texture index and selection flag. (Vertex attributes 3 ~ 7)
+    // Only the instances which changed are uploaded again.
+    template<typename T>
+    class InstanceModel : public T {
+    public:
+        // Number of the textures the instances can choose from.
+        static const int MAX_TEXTURES = 4;
+
+        using T::T;
+
+        ~InstanceModel() {
+            // Nothing to free if the context is already gone.
+            if (m_vertexArrayId == 0 || !Backend::isContextCurrent()) {
+                return;
+            }
+
+            GLState::releaseVertexArray(m_vertexArrayId);
+            glDeleteVertexArrays(1, &m_vertexArrayId);
+            glDeleteBuffers(1, &m_instanceBufferId);
+        }
+
+        // Add an instance and return its index.
+        int addInstance(const glm::mat4 &matrix, GLint textureIndex = 0) {
+            m_instanceList.push_back({matrix, textureIndex, 0});
+            markDirty(m_instanceList.size() - 1);
+            m_isBoundsDirty = true;
+
+            return static_cast<int>(m_instanceList.size() - 1);
+        }
+
+        // Remove an instance. (The last instance takes its index.)
+        void removeInstance(int index) {
+            m_instanceList[index] = m_instanceList.back();
+            m_instanceList.pop_back();
+            m_isBoundsDirty = true;
+
+            if (index < static_cast<int>(m_instanceList.size())) {
+                markDirty(static_cast<size_t>(index));
+            }
+        }
+
+        void setInstanceMatrix(int index, const glm::mat4 &matrix) {
+            m_instanceList[index].matrix = matrix;
+            markDirty(static_cast<size_t>(index));
+            m_isBoundsDirty = true;
+        }
+
+        void setInstanceTextureIndex(int index, GLint textureIndex) {
+            m_instanceList[index].textureIndex = textureIndex;
+            markDirty(static_cast<size_t>(index));
+        }
+
+        void setInstanceSelected(int index, bool isSelected) {
+            m_instanceList[index].isSelected = isSelected ? 1 : 0;
+            markDirty(static_cast<size_t>(index));
+        }
+
+        // Texture which the instances with the texture index use.
+        void setInstanceTexture(int textureIndex, Texture *texture) {
+            m_instanceTextureList[textureIndex] = texture;
+        }
+
+        glm::mat4 getInstanceMatrix(int index) const {
+            return m_instanceList[index].matrix;
+        }
+
+        // Bounds of one instance in world space.
+        Bounds getInstanceBounds(int index) const {
+            return this->m_mesh->getBounds().transform(m_instanceList[index].matrix);
+        }
+
+        int getInstanceCount() const {
+            return static_cast<int>(m_instanceList.size());
+        }
+
+        // Bounds of all the instances. (They are drawn or culled together.)
+        Bounds getBounds() const override {
+            auto &meshBounds = this->m_mesh->getBounds();
+
+            if (meshBounds.isEmpty) {
+                return meshBounds;
+            }
+
+            if (m_isBoundsDirty) {
+                m_bounds = Bounds();
+
+                for (auto &instance: m_instanceList) {
+                    m_bounds = m_bounds.merge(meshBounds.transform(instance.matrix));
+                }
+
+                m_isBoundsDirty = false;
+            }
+
+            return m_bounds;
+        }
+
+        GLuint getVertexArrayId() const override {
+            return m_vertexArrayId;
+        }
+
+    protected:
+        // Per-instance attributes. (Layout of the instance buffer.)
+        struct Instance {
+            glm::mat4 matrix;
+            GLint textureIndex;
+            GLint isSelected;
+        };
+
+        virtual void onDraw() {
+            T::onDraw();
+
+            static const UniformHandle<GLint> isInstanced{"isInstanced"};
+            static const std::vector<UniformHandle<GLint>> textureUnitList = {
+                    UniformHandle<GLint>{"instanceTextureUnitList[0]"},
+                    UniformHandle<GLint>{"instanceTextureUnitList[1]"},
+                    UniformHandle<GLint>{"instanceTextureUnitList[2]"},
+                    UniformHandle<GLint>{"instanceTextureUnitList[3]"}
+            };
+
+            this->m_program->setUniform(isInstanced, 1);
+
+            for (int i = 0; i < MAX_TEXTURES; i++) {
+                if (m_instanceTextureList[i] != nullptr) {
+                    this->m_program->setUniform(textureUnitList[i], m_instanceTextureList[i]->getUnit());
+                }
+            }
+        }
+
+        virtual void onDrawMesh() {
+            if (m_instanceList.empty()) {
+                return;
+            }
+
+            if (m_vertexArrayId == 0) {
+                createVertexArray();
+            }
+
+            uploadInstances();
+
+            GLState::bindVertexArray(m_vertexArrayId);
+            this->m_mesh->drawInstanced(this->m_drawMode, static_cast<GLsizei>(m_instanceList.size()));
+        }
+
+    private:
+        void markDirty(size_t index) {
+            m_dirtyBegin = std::min(m_dirtyBegin, index);
+            m_dirtyEnd = std::max(m_dirtyEnd, index + 1);
+        }
+
+        // Build our own VAO over the shared mesh buffers, plus the instance buffer.
+        void createVertexArray() {
+            glGenVertexArrays(1, &m_vertexArrayId);
+            glGenBuffers(1, &m_instanceBufferId);
+
+            GLState::bindVertexArray(m_vertexArrayId);
+            this->m_mesh->bindBuffers();
+
+            glBindBuffer(GL_ARRAY_BUFFER, m_instanceBufferId);
+
+            auto stride = static_cast<GLsizei>(sizeof(Instance));
+
+            // Model matrix. (One attribute per column.)
+            for (GLuint column = 0; column < 4; column++) {
+                auto offset = offsetof(Instance, matrix) + column * sizeof(glm::vec4);
+
+                glEnableVertexAttribArray(3 + column);
+                glVertexAttribPointer(3 + column, 4, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<const void *>(offset));
+                glVertexAttribDivisor(3 + column, 1);
+            }
+
+            // Texture index & selection flag.
+            glEnableVertexAttribArray(7);
+            glVertexAttribIPointer(7, 2, GL_INT, stride, reinterpret_cast<const void *>(offsetof(Instance, textureIndex)));
+            glVertexAttribDivisor(7, 1);
+
+            GLState::bindVertexArray(0);
+        }
+
+        // Upload the dirty range of the instances. (Grow the buffer if needed.)
+        void uploadInstances() {
+            auto count = m_instanceList.size();
+
+            if (m_dirtyBegin >= m_dirtyEnd && count <= m_capacity) {
+                return;
+            }
+
+            glBindBuffer(GL_ARRAY_BUFFER, m_instanceBufferId);
+
+            if (count > m_capacity) {
+                m_capacity = std::max(count, m_capacity * 2);
+
+                glBufferData(GL_ARRAY_BUFFER, m_capacity * sizeof(Instance), nullptr, GL_DYNAMIC_DRAW);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(Instance), m_instanceList.data());
+            }
+            else {
+                auto end = std::min(m_dirtyEnd, count);
+
+                if (m_dirtyBegin < end) {
+                    glBufferSubData(
+                            GL_ARRAY_BUFFER,
+                            m_dirtyBegin * sizeof(Instance),
+                            (end - m_dirtyBegin) * sizeof(Instance),
+                            m_instanceList.data() + m_dirtyBegin
+                    );
+                }
+            }
+
+            m_dirtyBegin = SIZE_MAX;
+            m_dirtyEnd = 0;
+        }
+
+        std::vector<Instance> m_instanceList;
+        Texture *m_instanceTextureList[MAX_TEXTURES] = {nullptr, nullptr, nullptr, nullptr};
+
+        // Instances in [m_dirtyBegin, m_dirtyEnd) changed after the last upload.
+        size_t m_dirtyBegin = SIZE_MAX;
+        size_t m_dirtyEnd = 0;
+
+        // Union of the instance bounds. (Recomputed when a matrix changes.)
+        mutable Bounds m_bounds;
+        mutable bool m_isBoundsDirty = true;
+
+        GLuint m_vertexArrayId = 0;
+        GLuint m_instanceBufferId = 0;
+        // Number of the instances the buffer can hold.
+        size_t m_capacity = 0;
+    };
+}
+
+#endif
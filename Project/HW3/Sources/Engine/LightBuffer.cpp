@@ -0,0 +1,52 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    LightBuffer::LightBuffer() :
+            m_lightList(MAX_LIGHTS),
+            m_isDirty(true),
+            m_buffer(UniformBuffer::Binding::LIGHT, MAX_LIGHTS * sizeof(LightData)) {
+        for (auto &light: m_lightList) {
+            light.type = Light::Type::OFF;
+        }
+    }
+
+    void LightBuffer::setLight(int index, const Light &light) {
+        if (index < 0 || index >= MAX_LIGHTS) {
+            throw std::runtime_error("Error: Invalid light index " + std::to_string(index));
+        }
+
+        m_lightList[index] = light;
+        m_isDirty = true;
+    }
+
+    const Light &LightBuffer::getLight(int index) const {
+        return m_lightList.at(static_cast<size_t>(index));
+    }
+
+    void LightBuffer::update() {
+        if (!m_isDirty) {
+            return;
+        }
+
+        LightData dataList[MAX_LIGHTS];
+
+        for (int i = 0; i < MAX_LIGHTS; i++) {
+            auto &light = m_lightList[i];
+            auto &data = dataList[i];
+
+            data.position = light.position;
+            data.type = static_cast<GLint>(light.type);
+            data.direction = light.direction;
+            data.angle = light.angle;
+            data.ambient = light.ambient;
+            data.attenuation = light.attenuation;
+            data.diffuse = light.diffuse;
+            data.padding0 = 0.0f;
+            data.specular = light.specular;
+            data.padding1 = 0.0f;
+        }
+
+        m_buffer.update(dataList);
+        m_isDirty = false;
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef ENGINE_LIGHT_BUFFER_HPP
+#define ENGINE_LIGHT_BUFFER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Light list shared by all programs. (Uniform block "LightBlock" in the shaders.)
+    // Set the lights, then call update() once per frame.
+    class LightBuffer {
+    public:
+        static const int MAX_LIGHTS = 5;
+
+        LightBuffer();
+
+        void setLight(int index, const Light &light);
+        const Light &getLight(int index) const;
+
+        // Upload the lights if they changed.
+        void update();
+
+    private:
+        // std140 layout of a single light. (Must match the struct Light in the shaders.)
+        struct LightData {
+            glm::vec3 position;
+            GLint type;
+            glm::vec3 direction;
+            GLfloat angle;
+            glm::vec3 ambient;
+            GLfloat attenuation;
+            glm::vec3 diffuse;
+            GLfloat padding0;
+            glm::vec3 specular;
+            GLfloat padding1;
+        };
+
+        static_assert(sizeof(LightData) == 80, "LightData doesn't match the std140 layout.");
+
+        std::vector<Light> m_lightList;
+        bool m_isDirty;
+
+        UniformBuffer m_buffer;
+    };
+}
+
+#endif
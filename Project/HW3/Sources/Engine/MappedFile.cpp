@@ -0,0 +1,202 @@
+#include "Engine.hpp"
+
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+
+#include <windows.h>
+#else
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#endif
+
+namespace Engine {
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::string &path) {
+        HANDLE file = CreateFileA(
+                path.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                nullptr
+        );
+
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Error: File \"" + path + "\" does not exist.");
+        }
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(file, &size);
+
+        m_fileHandle = file;
+        m_size = static_cast<size_t>(size.QuadPart);
+
+        // Windows can't map an empty file.
+        if (m_size == 0) {
+            return;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            throw std::runtime_error("Error: Failed to map \"" + path + "\".");
+        }
+
+        m_mappingHandle = mapping;
+        m_data = static_cast<const unsigned char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (m_data == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw std::runtime_error("Error: Failed to map \"" + path + "\".");
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data != nullptr) {
+            UnmapViewOfFile(m_data);
+        }
+
+        if (m_mappingHandle != nullptr) {
+            CloseHandle(m_mappingHandle);
+        }
+
+        if (m_fileHandle != nullptr) {
+            CloseHandle(m_fileHandle);
+        }
+    }
+#else
+    MappedFile::MappedFile(const std::string &path) {
+        int file = open(path.c_str(), O_RDONLY);
+
+        if (file < 0) {
+            throw std::runtime_error("Error: File \"" + path + "\" does not exist.");
+        }
+
+        struct stat status{};
+
+        if (fstat(file, &status) != 0) {
+            close(file);
+            throw std::runtime_error("Error: Failed to read \"" + path + "\".");
+        }
+
+        m_size = static_cast<size_t>(status.st_size);
+
+        // mmap() rejects an empty range.
+        if (m_size > 0) {
+            void *data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+            if (data == MAP_FAILED) {
+                close(file);
+                throw std::runtime_error("Error: Failed to map \"" + path + "\".");
+            }
+
+            m_data = static_cast<const unsigned char *>(data);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        close(file);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data != nullptr) {
+            munmap(const_cast<unsigned char *>(m_data), m_size);
+        }
+    }
+#endif
+
+    const unsigned char *MappedFile::getData() const {
+        return m_data;
+    }
+
+    size_t MappedFile::getSize() const {
+        return m_size;
+    }
+
+    bool MappedFile::readStatus(const std::string &path, uint64_t &size, int64_t &time) {
+        struct stat status{};
+
+        if (stat(path.c_str(), &status) != 0) {
+            return false;
+        }
+
+        size = static_cast<uint64_t>(status.st_size);
+
+        // Use nanoseconds where we can, so that two writes within a second are still told apart.
+#if defined(__APPLE__)
+        time = static_cast<int64_t>(status.st_mtimespec.tv_sec) * 1000000000 + status.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+        time = static_cast<int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#else
+        time = static_cast<int64_t>(status.st_mtime) * 1000000000;
+#endif
+
+        return true;
+    }
+
+    uint64_t MappedFile::hashFile(const std::string &path) {
+        MappedFile file(path);
+
+        return hashBytes(file.getData(), file.getSize());
+    }
+
+    bool MappedFile::writeAtomically(
+            const std::string &path,
+            const std::vector<std::pair<const void *, size_t>> &partList
+    ) {
+        auto tempPath = path + ".tmp";
+
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+
+            if (!stream.is_open()) {
+                return false;
+            }
+
+            for (auto &part : partList) {
+                stream.write(static_cast<const char *>(part.first), static_cast<std::streamsize>(part.second));
+            }
+
+            if (!stream.good()) {
+                stream.close();
+                std::remove(tempPath.c_str());
+                return false;
+            }
+        }
+
+        // (rename() doesn't overwrite an existing file on Windows.)
+        std::remove(path.c_str());
+
+        if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool MappedFile::writeAtomically(const std::string &path, const void *data, size_t size) {
+        return writeAtomically(path, {{data, size}});
+    }
+
+    bool MappedFile::overwrite(const std::string &path, size_t offset, const void *data, size_t size) {
+        std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+
+        if (!stream.is_open()) {
+            return false;
+        }
+
+        stream.seekp(static_cast<std::streamoff>(offset));
+        stream.write(static_cast<const char *>(data), static_cast<std::streamsize>(size));
+
+        return stream.good();
+    }
+}
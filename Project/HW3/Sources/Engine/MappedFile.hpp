@@ -0,0 +1,46 @@
+#ifndef ENGINE_MAPPED_FILE_HPP
+#define ENGINE_MAPPED_FILE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Read-only memory mapping of a whole file.
+    class MappedFile {
+    public:
+        // Map the file. Throws if the file can't be opened or mapped.
+        explicit MappedFile(const std::string &path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        const unsigned char *getData() const;
+        size_t getSize() const;
+
+        // Size and modification time (ns) of the file, without mapping it. Returns false if it doesn't exist.
+        static bool readStatus(const std::string &path, uint64_t &size, int64_t &time);
+
+        // Hash of the whole file. (Throws like the constructor.)
+        static uint64_t hashFile(const std::string &path);
+
+        // Write the parts into the file, one after another, replacing it as a whole. Returns false on failure.
+        // (They go to a temporary file which is then renamed, so a crash never leaves a half-written file behind.)
+        static bool writeAtomically(const std::string &path, const std::vector<std::pair<const void *, size_t>> &partList);
+        static bool writeAtomically(const std::string &path, const void *data, size_t size);
+
+        // Overwrite size bytes at offset in an existing file. Returns false if it can't be written.
+        // (Unmap the file first: Windows can't write to a mapped file.)
+        static bool overwrite(const std::string &path, size_t offset, const void *data, size_t size);
+
+    private:
+        const unsigned char *m_data = nullptr;
+        size_t m_size = 0;
+
+#ifdef _WIN32
+        void *m_fileHandle = nullptr;
+        void *m_mappingHandle = nullptr;
+#endif
+    };
+}
+
+#endif
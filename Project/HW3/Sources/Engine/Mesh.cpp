@@ -0,0 +1,128 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    Mesh::~Mesh() {
+        // Nothing to free if the context is already gone. (ex. Static meshes after the backend is closed.)
+        if (!m_isCreated || !Backend::isContextCurrent()) {
+            return;
+        }
+
+        if (m_vertexBufferId != 0) {
+            glDeleteBuffers(1, &m_vertexBufferId);
+        }
+
+        if (m_indexBufferId != 0) {
+            glDeleteBuffers(1, &m_indexBufferId);
+        }
+
+        GLState::releaseVertexArray(m_vertexArrayId);
+        glDeleteVertexArrays(1, &m_vertexArrayId);
+    }
+
+    void Mesh::create() {
+        glGenVertexArrays(1, &m_vertexArrayId);
+        m_isCreated = true;
+    }
+
+    void Mesh::setVertices(
+            const VertexLayout &layout,
+            const glm::vec3 *positionData,
+            const glm::vec3 *normalData,
+            const glm::vec2 *uvData,
+            size_t count
+    ) {
+        auto usedLayout = layout.fit(positionData, normalData, uvData, count);
+        auto buffer = usedLayout.pack(positionData, normalData, uvData, count);
+
+        if (m_vertexBufferId == 0) {
+            glGenBuffers(1, &m_vertexBufferId);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
+        glBufferData(GL_ARRAY_BUFFER, buffer.size(), buffer.data(), GL_STATIC_DRAW);
+        usedLayout.apply();
+
+        m_vertexLayout = usedLayout;
+        m_vertexCount = static_cast<GLsizei>(count);
+        m_bounds = Bounds::fromPoints(positionData, count);
+    }
+
+    void Mesh::setIndices(const GLuint *data, size_t count) {
+        if (m_indexBufferId == 0) {
+            glGenBuffers(1, &m_indexBufferId);
+        }
+
+        // (The binding is recorded in the VAO.)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferId);
+
+        GLuint maxIndex = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            maxIndex = std::max(maxIndex, data[i]);
+        }
+
+        if (maxIndex <= 0xFFFF) {
+            std::vector<GLushort> shortList(data, data + count);
+
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLushort), shortList.data(), GL_STATIC_DRAW);
+            m_indexType = GL_UNSIGNED_SHORT;
+        }
+        else {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(GLuint), data, GL_STATIC_DRAW);
+            m_indexType = GL_UNSIGNED_INT;
+        }
+
+        m_indexCount = static_cast<GLsizei>(count);
+    }
+
+    void Mesh::draw(GLenum mode) const {
+        if (isIndexed()) {
+            glDrawElements(mode, m_indexCount, m_indexType, nullptr);
+        }
+        else {
+            glDrawArrays(mode, 0, m_vertexCount);
+        }
+    }
+
+    void Mesh::drawInstanced(GLenum mode, GLsizei instanceCount) const {
+        if (isIndexed()) {
+            glDrawElementsInstanced(mode, m_indexCount, m_indexType, nullptr, instanceCount);
+        }
+        else {
+            glDrawArraysInstanced(mode, 0, m_vertexCount, instanceCount);
+        }
+    }
+
+    void Mesh::bindBuffers() const {
+        glBindBuffer(GL_ARRAY_BUFFER, m_vertexBufferId);
+        m_vertexLayout.apply();
+
+        if (isIndexed()) {
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferId);
+        }
+    }
+
+    bool Mesh::isCreated() const {
+        return m_isCreated;
+    }
+
+    bool Mesh::isIndexed() const {
+        return m_indexBufferId != 0;
+    }
+
+    GLuint Mesh::getVertexArrayId() const {
+        return m_vertexArrayId;
+    }
+
+    GLsizei Mesh::getVertexCount() const {
+        return m_vertexCount;
+    }
+
+    GLsizei Mesh::getIndexCount() const {
+        return m_indexCount;
+    }
+
+    const Bounds &Mesh::getBounds() const {
+        return m_bounds;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef ENGINE_MESH_HPP
+#define ENGINE_MESH_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // GPU side of a model: The VAO, its VBO and the number of vertices to draw.
+    // Models which load the same asset share one mesh. (See MeshRegistry.)
+    class Mesh {
+    public:
+        Mesh() = default;
+        ~Mesh();
+
+        Mesh(const Mesh &) = delete;
+        Mesh &operator=(const Mesh &) = delete;
+
+        // Generate the VAO.
+        void create();
+
+        // Interleave the streams into the VBO using the layout, and set the attributes. (The VAO should be bound.)
+        // Pass nullptr for the streams we don't have. (See VertexLayout::fit().)
+        void setVertices(
+                const VertexLayout &layout,
+                const glm::vec3 *positionData,
+                const glm::vec3 *normalData,
+                const glm::vec2 *uvData,
+                size_t count
+        );
+
+        // Upload the index list and draw with glDrawElements() from now on. (The VAO should be bound.)
+        // 16-bit indices are used if every index fits.
+        void setIndices(const GLuint *data, size_t count);
+
+        // Issue the draw call. (The VAO should be bound.)
+        void draw(GLenum mode) const;
+        void drawInstanced(GLenum mode, GLsizei instanceCount) const;
+
+        // Bind the VBO & the element buffer and set the attributes into the currently bound VAO.
+        // (For building another VAO over the same buffers. See InstanceModel.)
+        void bindBuffers() const;
+
+        bool isCreated() const;
+        bool isIndexed() const;
+        GLuint getVertexArrayId() const;
+        GLsizei getVertexCount() const;
+        GLsizei getIndexCount() const;
+        // Bounds of the vertex positions. (In model space.)
+        const Bounds &getBounds() const;
+
+    private:
+        bool m_isCreated = false;
+        GLuint m_vertexArrayId = 0;
+        GLsizei m_vertexCount = 0;
+        GLuint m_vertexBufferId = 0;
+        // Format of the vertices in the VBO. (After VertexLayout::fit().)
+        VertexLayout m_vertexLayout;
+
+        // Element buffer. (0 if we draw the vertices in order.)
+        GLuint m_indexBufferId = 0;
+        GLsizei m_indexCount = 0;
+        // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT.
+        GLenum m_indexType = GL_UNSIGNED_INT;
+
+        // Computed in setVertices(), so the models sharing the mesh don't need the positions.
+        Bounds m_bounds;
+    };
+}
+
+#endif
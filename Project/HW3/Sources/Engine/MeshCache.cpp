@@ -0,0 +1,132 @@
+#include "Engine.hpp"
+
+static const char MAGIC[4] = {'C', 'G', 'L', 'M'};
+
+namespace Engine {
+    std::unique_ptr<MeshCache> MeshCache::load(const std::string &sourcePath) {
+        uint64_t sourceSize;
+        int64_t sourceTime;
+
+        if (!MappedFile::readStatus(sourcePath, sourceSize, sourceTime)) {
+            return nullptr;
+        }
+
+        std::unique_ptr<MappedFile> file;
+
+        try {
+            file.reset(new MappedFile(getCachePath(sourcePath)));
+        }
+        catch (const std::runtime_error &) {
+            return nullptr;
+        }
+
+        if (file->getSize() < sizeof(Header)) {
+            return nullptr;
+        }
+
+        auto header = reinterpret_cast<const Header *>(file->getData());
+
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+            || header->version != VERSION
+            || header->sourceSize != sourceSize) {
+            return nullptr;
+        }
+
+        auto vertexSize = 2 * sizeof(glm::vec3) + sizeof(glm::vec2);
+
+        if (file->getSize() != sizeof(Header) + header->vertexCount * vertexSize + header->indexCount * sizeof(GLuint)) {
+            return nullptr;
+        }
+
+        // The source was touched. Only rebuild if its contents really changed.
+        if (header->sourceTime != sourceTime) {
+            if (header->sourceHash != MappedFile::hashFile(sourcePath)) {
+                return nullptr;
+            }
+
+            // Same contents: Store the new time, so that the next loads skip the hash again.
+            file.reset();
+
+            if (MappedFile::overwrite(getCachePath(sourcePath), offsetof(Header, sourceTime), &sourceTime, sizeof(sourceTime))) {
+                return load(sourcePath);
+            }
+
+            // (Read-only: Use the cache anyway, and hash again next time.)
+            try {
+                file.reset(new MappedFile(getCachePath(sourcePath)));
+            }
+            catch (const std::runtime_error &) {
+                return nullptr;
+            }
+        }
+
+        return std::unique_ptr<MeshCache>(new MeshCache(std::move(file)));
+    }
+
+    void MeshCache::save(
+            const std::string &sourcePath,
+            const std::vector<glm::vec3> &positionList,
+            const std::vector<glm::vec3> &normalList,
+            const std::vector<glm::vec2> &uvList,
+            const std::vector<GLuint> &indexList
+    ) {
+        if (normalList.size() != positionList.size() || uvList.size() != positionList.size()) {
+            return;
+        }
+
+        Header header{};
+
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.vertexCount = positionList.size();
+        header.indexCount = indexList.size();
+
+        if (!MappedFile::readStatus(sourcePath, header.sourceSize, header.sourceTime)) {
+            return;
+        }
+
+        header.sourceHash = MappedFile::hashFile(sourcePath);
+
+        MappedFile::writeAtomically(getCachePath(sourcePath), {
+                {&header, sizeof(Header)},
+                {positionList.data(), positionList.size() * sizeof(glm::vec3)},
+                {normalList.data(), normalList.size() * sizeof(glm::vec3)},
+                {uvList.data(), uvList.size() * sizeof(glm::vec2)},
+                {indexList.data(), indexList.size() * sizeof(GLuint)}
+        });
+    }
+
+    std::string MeshCache::getCachePath(const std::string &sourcePath) {
+        return sourcePath + ".mesh";
+    }
+
+    size_t MeshCache::getVertexCount() const {
+        return static_cast<size_t>(getHeader()->vertexCount);
+    }
+
+    size_t MeshCache::getIndexCount() const {
+        return static_cast<size_t>(getHeader()->indexCount);
+    }
+
+    const glm::vec3 *MeshCache::getPositionData() const {
+        return reinterpret_cast<const glm::vec3 *>(m_file->getData() + sizeof(Header));
+    }
+
+    const glm::vec3 *MeshCache::getNormalData() const {
+        return getPositionData() + getVertexCount();
+    }
+
+    const glm::vec2 *MeshCache::getUVData() const {
+        return reinterpret_cast<const glm::vec2 *>(getNormalData() + getVertexCount());
+    }
+
+    const GLuint *MeshCache::getIndexData() const {
+        return reinterpret_cast<const GLuint *>(getUVData() + getVertexCount());
+    }
+
+    MeshCache::MeshCache(std::unique_ptr<MappedFile> file) : m_file(std::move(file)) {}
+
+    const MeshCache::Header *MeshCache::getHeader() const {
+        return reinterpret_cast<const Header *>(m_file->getData());
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef ENGINE_MESH_CACHE_HPP
+#define ENGINE_MESH_CACHE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Binary copy of a mesh's final attribute streams and index list, stored next to the source file.
+    // The cache is keyed by the source's size, modification time and content hash, and is memory-mapped on load,
+    // so the streams can be uploaded without parsing or copying them.
+    class MeshCache {
+    public:
+        // Bump this whenever the layout of the file changes.
+        static const uint32_t VERSION = 2;
+
+        // Map the cache of the source file. Returns nullptr if the cache is missing, broken or stale.
+        static std::unique_ptr<MeshCache> load(const std::string &sourcePath);
+
+        // Write the cache of the source file. Failure is not fatal: We just parse the source again next time.
+        static void save(
+                const std::string &sourcePath,
+                const std::vector<glm::vec3> &positionList,
+                const std::vector<glm::vec3> &normalList,
+                const std::vector<glm::vec2> &uvList,
+                const std::vector<GLuint> &indexList
+        );
+
+        static std::string getCachePath(const std::string &sourcePath);
+
+        size_t getVertexCount() const;
+        size_t getIndexCount() const;
+
+        // Pointers into the mapping. Valid while this object is alive.
+        const glm::vec3 *getPositionData() const;
+        const glm::vec3 *getNormalData() const;
+        const glm::vec2 *getUVData() const;
+        const GLuint *getIndexData() const;
+
+    private:
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceSize;
+            int64_t sourceTime;
+            uint64_t sourceHash;
+            uint64_t vertexCount;
+            uint64_t indexCount;
+        };
+
+        explicit MeshCache(std::unique_ptr<MappedFile> file);
+
+        const Header *getHeader() const;
+
+        std::unique_ptr<MappedFile> m_file;
+    };
+}
+
+#endif
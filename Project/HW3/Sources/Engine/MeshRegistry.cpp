@@ -0,0 +1,75 @@
+#include "Engine.hpp"
+
+#ifdef _WIN32
+
+#include <cstdlib>
+
+#else
+
+#include <climits>
+
+#endif
+
+// Map of (canonical path + options, mesh).
+static std::map<std::string, std::weak_ptr<Engine::Mesh>> meshMap;
+
+static std::string canonicalizePath(const std::string &path);
+static void removeExpiredMeshes();
+
+namespace Engine {
+    std::shared_ptr<Mesh> MeshRegistry::acquire(const std::string &path, const std::string &options) {
+        auto key = canonicalizePath(path) + "?" + options;
+        auto it = meshMap.find(key);
+
+        if (it != meshMap.end()) {
+            auto mesh = it->second.lock();
+
+            if (mesh != nullptr) {
+                return mesh;
+            }
+        }
+
+        removeExpiredMeshes();
+
+        auto mesh = std::make_shared<Mesh>();
+        meshMap[key] = mesh;
+
+        return mesh;
+    }
+
+    size_t MeshRegistry::getSize() {
+        removeExpiredMeshes();
+
+        return meshMap.size();
+    }
+}
+
+// Resolve ".", "..", and links so that different spellings of one file give the same key.
+static std::string canonicalizePath(const std::string &path) {
+#ifdef _WIN32
+    char buffer[_MAX_PATH];
+
+    if (_fullpath(buffer, path.c_str(), _MAX_PATH) != nullptr) {
+        return buffer;
+    }
+#else
+    char buffer[PATH_MAX];
+
+    if (realpath(path.c_str(), buffer) != nullptr) {
+        return buffer;
+    }
+#endif
+
+    return path;
+}
+
+static void removeExpiredMeshes() {
+    for (auto it = meshMap.begin(); it != meshMap.end();) {
+        if (it->second.expired()) {
+            it = meshMap.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef ENGINE_MESH_REGISTRY_HPP
+#define ENGINE_MESH_REGISTRY_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Registry of the meshes loaded from files. Placing the same asset N times costs one parse, one upload and
+    // one set of buffers: Every model gets a reference to the same mesh, which is freed with its last user.
+    class MeshRegistry {
+    public:
+        // Return the mesh registered for the file, or register a new (not created) one.
+        // 'options' should describe every processing step which changes the result, so that
+        // different processing of the same file doesn't collide.
+        static std::shared_ptr<Mesh> acquire(const std::string &path, const std::string &options);
+
+        // Number of meshes which are still used by some model.
+        static size_t getSize();
+    };
+}
+
+#endif
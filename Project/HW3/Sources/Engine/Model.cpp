@@ -1,15 +1,12 @@
 #include "Engine.hpp"
 
+static const Engine::UniformHandle<glm::mat4> MODEL_MATRIX{"modelMatrix"}; // NOLINT
+static const Engine::UniformHandle<GLint> IS_INSTANCED{"isInstanced"}; // NOLINT
+
 namespace Engine {
     void Model::draw() {
-        if (!m_isCreated) {
-            glGenVertexArrays(1, &m_vertexArrayId);
-
-            glBindVertexArray(m_vertexArrayId);
-            onCreate();
-            glBindVertexArray(0);
-
-            m_isCreated = true;
+        if (!m_mesh->isCreated()) {
+            create();
         }
 
         if (m_program == nullptr) {
@@ -20,10 +17,8 @@ namespace Engine {
 
         onDraw();
 
-        glBindVertexArray(m_vertexArrayId);
-        glPolygonMode(GL_FRONT_AND_BACK, m_fillMode);
-        glDrawArrays(m_drawMode, 0, static_cast<GLsizei>(m_positionList.size()));
-        glBindVertexArray(0);
+        GLState::setPolygonMode(m_fillMode);
+        onDrawMesh();
     }
 
     void Model::generateNormalList() {
@@ -39,16 +34,24 @@ namespace Engine {
         }
     }
 
+    void Model::setVertexLayout(const VertexLayout &layout) {
+        m_vertexLayout = layout;
+    }
+
     glm::mat4 Model::getModelMatrix() const {
         return m_modelMatrix;
     }
 
-    glm::mat4 Model::getViewMatrix() const {
-        return m_viewMatrix;
+    Bounds Model::getBounds() const {
+        return m_mesh->getBounds().transform(m_modelMatrix);
+    }
+
+    GLuint Model::getVertexArrayId() const {
+        return m_mesh->getVertexArrayId();
     }
 
-    glm::mat4 Model::getProjectionMatrix() const {
-        return m_projectionMatrix;
+    GLuint Model::getTextureId() const {
+        return 0;
     }
 
     void Model::setFillMode(FillMode fillMode) {
@@ -63,47 +66,40 @@ namespace Engine {
         m_program = program;
     }
 
-    void Model::setCameraPosition(const glm::vec3 &position) {
-        m_cameraPosition = position;
-    }
-
     void Model::setModelMatrix(const glm::mat4 &matrix) {
         m_modelMatrix = matrix;
     }
 
-    void Model::setViewMatrix(const glm::mat4 &matrix) {
-        m_viewMatrix = matrix;
-    }
-
-    void Model::setProjectionMatrix(const glm::mat4 &matrix) {
-        m_projectionMatrix = matrix;
-    }
-
     void Model::onCreate() {
-        initAttribute(0, 3, sizeof(glm::vec3));
-        initAttribute(1, 3, sizeof(glm::vec3));
-
-        setAttribute(0, m_positionList);
-        setAttribute(1, m_normalList);
+        m_mesh->setVertices(
+                m_vertexLayout,
+                m_positionList.data(),
+                m_normalList.empty() ? nullptr : m_normalList.data(),
+                m_uvList.empty() ? nullptr : m_uvList.data(),
+                m_positionList.size()
+        );
+
+        if (!m_indexList.empty()) {
+            m_mesh->setIndices(m_indexList.data(), m_indexList.size());
+        }
     }
 
     void Model::onDraw() {
-        m_program->setUniform("cameraPosition", m_cameraPosition);
-        m_program->setUniform("modelMatrix", m_modelMatrix);
-        m_program->setUniform("viewMatrix", m_viewMatrix);
-        m_program->setUniform("projectionMatrix", m_projectionMatrix);
+        m_program->setUniform(MODEL_MATRIX, m_modelMatrix);
+        m_program->setUniform(IS_INSTANCED, 0);
     }
 
-    void Model::initAttribute(GLuint index, GLint size, GLsizei stride) {
-        // Generate a VBO for the attribute.
-        GLuint vboId;
+    void Model::onDrawMesh() {
+        // (The VAO stays bound. The next draw binds its own one if needed.)
+        GLState::bindVertexArray(m_mesh->getVertexArrayId());
+        m_mesh->draw(m_drawMode);
+    }
 
-        glGenBuffers(1, &vboId);
-        m_attributeCache[index] = vboId;
+    void Model::create() {
+        m_mesh->create();
 
-        // Set the index of the attribute.
-        glEnableVertexAttribArray(index);
-        glBindBuffer(GL_ARRAY_BUFFER, m_attributeCache[index]);
-        glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, stride, nullptr);
+        GLState::bindVertexArray(m_mesh->getVertexArrayId());
+        onCreate();
+        GLState::bindVertexArray(0);
     }
 }
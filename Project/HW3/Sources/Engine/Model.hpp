@@ -19,58 +19,57 @@ namespace Engine {
 
         void generateNormalList();
 
+        // Choose how the vertices are stored. (Call before the first draw().)
+        void setVertexLayout(const VertexLayout &layout);
+
         // Getters.
         glm::mat4 getModelMatrix() const;
-        glm::mat4 getViewMatrix() const;
-        glm::mat4 getProjectionMatrix() const;
+
+        // Bounds in world space. (Empty until the mesh is uploaded.)
+        virtual Bounds getBounds() const;
+
+        // Objects the draw uses. (Sort keys of RenderQueue.)
+        virtual GLuint getVertexArrayId() const;
+        virtual GLuint getTextureId() const;
 
         // Setters.
         void setFillMode(FillMode fillMode);
         void setDrawMode(DrawMode drawMode);
         void setProgram(Program *program);
-        void setCameraPosition(const glm::vec3 &position);
         void setModelMatrix(const glm::mat4 &matrix);
-        void setViewMatrix(const glm::mat4 &matrix);
-        void setProjectionMatrix(const glm::mat4 &matrix);
 
     protected:
+        // Create the mesh and fill it using onCreate(). (draw() calls this if the mesh is not created yet.)
+        void create();
+
         virtual void onCreate();
+        // Set the uniforms.
         virtual void onDraw();
-
-        // Generate VBO and set the index for the attribute.
-        void initAttribute(GLuint index, GLint size, GLsizei stride);
-
-        // Set the value of the attributes in the shaders.
-        template<typename T>
-        void setAttribute(GLuint index, const std::vector<T> &buffer) {
-            glBindBuffer(GL_ARRAY_BUFFER, m_attributeCache[index]);
-            glBufferData(GL_ARRAY_BUFFER, buffer.size() * sizeof(T), buffer.data(), GL_STATIC_DRAW);
-        }
+        // Bind the VAO and issue the draw call.
+        virtual void onDrawMesh();
 
         // Draw all or draw skeleton.
         FillMode m_fillMode = FillMode::FILL;
         // Primitive to use.
         DrawMode m_drawMode = DrawMode::TRIANGLES;
 
-        GLuint m_vertexArrayId;
-        bool m_isCreated = false;
+        // VAO & VBO. (Shared with the other models if they load the same file.)
+        std::shared_ptr<Mesh> m_mesh = std::make_shared<Mesh>();
         Program *m_program = nullptr;
 
-        glm::vec3 m_cameraPosition;
-
         // List of vertex positions.
         std::vector<glm::vec3> m_positionList;
         // List of vertex normals.
         std::vector<glm::vec3> m_normalList;
-
-        // Model matrix.
+        // List of vertex UVs. (Empty if the model has no texture.)
+        std::vector<glm::vec2> m_uvList;
+        // List of vertex indices. (If empty, the vertices are drawn in order.)
+        std::vector<GLuint> m_indexList;
+        // Format of the vertices in the VBO.
+        VertexLayout m_vertexLayout;
+
+        // Model matrix. (The camera matrices are shared through the ViewBuffer.)
         glm::mat4 m_modelMatrix;
-        // View matrix.
-        glm::mat4 m_viewMatrix;
-        // Projection matrix.
-        glm::mat4 m_projectionMatrix;
-
-        std::map<GLuint, GLuint> m_attributeCache;
     };
 }
 
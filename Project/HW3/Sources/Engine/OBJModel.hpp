@@ -5,73 +5,90 @@
 
 namespace Engine {
     // Mixin for constructing the model from an .obj file.
+    // The parsed result is kept in a binary cache next to the file, so later runs skip the parsing. (See MeshCache.)
+    // Models which load the same file share one mesh. (See MeshRegistry.)
+    // Duplicated vertices are welded, and the mesh is drawn with an index buffer. (See VertexWelder.)
     template<typename T>
     class OBJModel : public T {
     public:
-        explicit OBJModel(const std::string &path) {
-            std::string basePath = path + "/../";
-            std::string error;
-            tinyobj::attrib_t attribute;
-            std::vector<tinyobj::shape_t> shapeList;
-            std::vector<tinyobj::material_t> materialList;
-
-            tinyobj::LoadObj(
-                    &attribute,
-                    &shapeList,
-                    &materialList,
-                    &error,
-                    path.c_str(),
-                    basePath.c_str(),
-                    true
-            );
+        // threadCount: Threads for parsing the file. (See OBJParser.)
+        // layout: Format of the vertices in the VBO. (See VertexLayout.)
+        explicit OBJModel(
+                const std::string &path,
+                int threadCount = OBJParser::SINGLE_THREAD,
+                const VertexLayout &layout = VertexLayout()
+        ) {
+            this->m_vertexLayout = layout;
+            this->m_mesh = MeshRegistry::acquire(path, "triangulate,weld," + layout.getKey());
 
-            if (!error.empty()) {
-                std::cout << error << "\n";
+            // Another model already loaded the file.
+            if (this->m_mesh->isCreated()) {
+                return;
             }
 
-            bool hasNormal = !attribute.normals.empty();
-            bool hasUV = !attribute.texcoords.empty();
-
-            for (auto &shape : shapeList) {
-                size_t indexOffset = 0;
-
-                for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++) {
-                    for (auto v = 0; v < 3; v++) {
-                        auto index = shape.mesh.indices[indexOffset + v];
-
-                        this->m_positionList.emplace_back(
-                                attribute.vertices[index.vertex_index * 3 + 0],
-                                attribute.vertices[index.vertex_index * 3 + 1],
-                                attribute.vertices[index.vertex_index * 3 + 2]
-                        );
-
-                        if (hasNormal) {
-                            this->m_normalList.emplace_back(
-                                    attribute.normals[index.normal_index * 3 + 0],
-                                    attribute.normals[index.normal_index * 3 + 1],
-                                    attribute.normals[index.normal_index * 3 + 2]
-                            );
-                        }
-
-                        if (hasUV) {
-                            this->m_uvList.emplace_back(
-                                    attribute.texcoords[index.texcoord_index * 2 + 0],
-                                    attribute.texcoords[index.texcoord_index * 2 + 1]
-                            );
-                        }
-                    }
-
-                    indexOffset += 3;
-                }
+            load(path, threadCount);
+
+            // Upload right away, so that the models sharing the mesh never need the data.
+            this->create();
+
+            this->m_positionList.clear();
+            this->m_positionList.shrink_to_fit();
+            this->m_normalList.clear();
+            this->m_normalList.shrink_to_fit();
+            this->m_uvList.clear();
+            this->m_uvList.shrink_to_fit();
+            this->m_indexList.clear();
+            this->m_indexList.shrink_to_fit();
+        }
+
+    protected:
+        virtual void onCreate() {
+            if (m_meshCache == nullptr) {
+                T::onCreate();
+                return;
             }
 
-            if (!hasNormal) {
+            // Upload straight from the mapping, then drop it.
+            this->m_mesh->setVertices(
+                    this->m_vertexLayout,
+                    m_meshCache->getPositionData(),
+                    m_meshCache->getNormalData(),
+                    m_meshCache->getUVData(),
+                    m_meshCache->getVertexCount()
+            );
+            this->m_mesh->setIndices(m_meshCache->getIndexData(), m_meshCache->getIndexCount());
+            m_meshCache.reset();
+        }
+
+        // Cached streams. (nullptr if we parsed the file.)
+        std::unique_ptr<MeshCache> m_meshCache;
+
+    private:
+        void load(const std::string &path, int threadCount) {
+            m_meshCache = MeshCache::load(path);
+
+            if (m_meshCache != nullptr) {
+                return;
+            }
+
+            OBJParser::parse(path, threadCount, this->m_positionList, this->m_normalList, this->m_uvList);
+
+            if (this->m_normalList.empty()) {
                 this->generateNormalList();
             }
 
-            if (!hasUV) {
+            if (this->m_uvList.empty()) {
                 this->generateUVList();
             }
+
+            auto vertexCount = this->m_positionList.size();
+
+            VertexWelder::weld(this->m_positionList, this->m_normalList, this->m_uvList, this->m_indexList);
+
+            std::cout << "Welded " << path << ": "
+                      << vertexCount << " -> " << this->m_positionList.size() << " vertices\n";
+
+            MeshCache::save(path, this->m_positionList, this->m_normalList, this->m_uvList, this->m_indexList);
         }
     };
 }
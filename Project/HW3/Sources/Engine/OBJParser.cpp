@@ -0,0 +1,219 @@
+#include "Engine.hpp"
+
+#include <atomic>
+#include <thread>
+
+#define TINYOBJ_LOADER_OPT_IMPLEMENTATION
+
+#include <experimental/tinyobj_loader_opt.h>
+
+// tinyobj_opt splits the file into one chunk per thread, and loses lines longer than a chunk.
+// So each parsing thread gets at least this many bytes. (Small files are parsed by a single thread.)
+static const size_t MIN_BYTES_PER_THREAD = 1 << 20;
+
+// Shapes are converted in blocks of (at most) this many faces, so that one big shape still keeps every thread busy.
+static const size_t FACES_PER_BLOCK = 1 << 16;
+
+static void parseSingleThreaded(
+        const std::string &path,
+        std::vector<glm::vec3> &positionList,
+        std::vector<glm::vec3> &normalList,
+        std::vector<glm::vec2> &uvList
+);
+
+static void parseMultiThreaded(
+        const std::string &path,
+        unsigned int threadCount,
+        std::vector<glm::vec3> &positionList,
+        std::vector<glm::vec3> &normalList,
+        std::vector<glm::vec2> &uvList
+);
+
+namespace Engine {
+    void OBJParser::parse(
+            const std::string &path,
+            int threadCount,
+            std::vector<glm::vec3> &positionList,
+            std::vector<glm::vec3> &normalList,
+            std::vector<glm::vec2> &uvList
+    ) {
+        if (threadCount == SINGLE_THREAD) {
+            parseSingleThreaded(path, positionList, normalList, uvList);
+            return;
+        }
+
+        if (threadCount == ALL_THREADS) {
+            threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        parseMultiThreaded(path, static_cast<unsigned int>(threadCount), positionList, normalList, uvList);
+    }
+}
+
+static void parseSingleThreaded(
+        const std::string &path,
+        std::vector<glm::vec3> &positionList,
+        std::vector<glm::vec3> &normalList,
+        std::vector<glm::vec2> &uvList
+) {
+    std::string basePath = path + "/../";
+    std::string error;
+    tinyobj::attrib_t attribute;
+    std::vector<tinyobj::shape_t> shapeList;
+    std::vector<tinyobj::material_t> materialList;
+
+    tinyobj::LoadObj(
+            &attribute,
+            &shapeList,
+            &materialList,
+            &error,
+            path.c_str(),
+            basePath.c_str(),
+            true
+    );
+
+    if (!error.empty()) {
+        std::cout << error << "\n";
+    }
+
+    bool hasNormal = !attribute.normals.empty();
+    bool hasUV = !attribute.texcoords.empty();
+
+    for (auto &shape : shapeList) {
+        size_t indexOffset = 0;
+
+        for (size_t f = 0; f < shape.mesh.num_face_vertices.size(); f++) {
+            for (auto v = 0; v < 3; v++) {
+                auto index = shape.mesh.indices[indexOffset + v];
+
+                positionList.emplace_back(
+                        attribute.vertices[index.vertex_index * 3 + 0],
+                        attribute.vertices[index.vertex_index * 3 + 1],
+                        attribute.vertices[index.vertex_index * 3 + 2]
+                );
+
+                if (hasNormal) {
+                    normalList.emplace_back(
+                            attribute.normals[index.normal_index * 3 + 0],
+                            attribute.normals[index.normal_index * 3 + 1],
+                            attribute.normals[index.normal_index * 3 + 2]
+                    );
+                }
+
+                if (hasUV) {
+                    uvList.emplace_back(
+                            attribute.texcoords[index.texcoord_index * 2 + 0],
+                            attribute.texcoords[index.texcoord_index * 2 + 1]
+                    );
+                }
+            }
+
+            indexOffset += 3;
+        }
+    }
+}
+
+static void parseMultiThreaded(
+        const std::string &path,
+        unsigned int threadCount,
+        std::vector<glm::vec3> &positionList,
+        std::vector<glm::vec3> &normalList,
+        std::vector<glm::vec2> &uvList
+) {
+    Engine::MappedFile file(path);
+    tinyobj_opt::attrib_t attribute;
+    std::vector<tinyobj_opt::shape_t> shapeList;
+    std::vector<tinyobj_opt::material_t> materialList;
+    tinyobj_opt::LoadOption option;
+
+    option.req_num_threads = static_cast<int>(std::max<size_t>(
+            1,
+            std::min<size_t>(threadCount, file.getSize() / MIN_BYTES_PER_THREAD)
+    ));
+    option.triangulate = true;
+
+    if (!tinyobj_opt::parseObj(
+            &attribute,
+            &shapeList,
+            &materialList,
+            reinterpret_cast<const char *>(file.getData()),
+            file.getSize(),
+            option
+    )) {
+        throw std::runtime_error("Error: Failed to parse \"" + path + "\".");
+    }
+
+    bool hasNormal = !attribute.normals.empty();
+    bool hasUV = !attribute.texcoords.empty();
+
+    // Split the shapes into blocks of faces, and find where each block goes in the streams.
+    // (Every face is a triangle, so face i starts at attribute.indices[i * 3].)
+    struct Block {
+        size_t firstFace;
+        size_t faceCount;
+        size_t firstVertex;
+    };
+
+    std::vector<Block> blockList;
+    size_t vertexCount = 0;
+
+    for (auto &shape : shapeList) {
+        for (size_t f = 0; f < shape.length; f += FACES_PER_BLOCK) {
+            auto faceCount = std::min<size_t>(FACES_PER_BLOCK, shape.length - f);
+
+            blockList.push_back({shape.face_offset + f, faceCount, vertexCount});
+            vertexCount += faceCount * 3;
+        }
+    }
+
+    positionList.resize(vertexCount);
+    normalList.resize(hasNormal ? vertexCount : 0);
+    uvList.resize(hasUV ? vertexCount : 0);
+
+    // Each thread takes the next block until none are left.
+    std::atomic<size_t> nextBlock(0);
+
+    auto convert = [&]() {
+        for (auto b = nextBlock++; b < blockList.size(); b = nextBlock++) {
+            auto &block = blockList[b];
+
+            for (size_t i = 0; i < block.faceCount * 3; i++) {
+                auto index = attribute.indices[block.firstFace * 3 + i];
+                auto v = block.firstVertex + i;
+
+                positionList[v] = glm::vec3(
+                        attribute.vertices[index.vertex_index * 3 + 0],
+                        attribute.vertices[index.vertex_index * 3 + 1],
+                        attribute.vertices[index.vertex_index * 3 + 2]
+                );
+
+                if (hasNormal) {
+                    normalList[v] = glm::vec3(
+                            attribute.normals[index.normal_index * 3 + 0],
+                            attribute.normals[index.normal_index * 3 + 1],
+                            attribute.normals[index.normal_index * 3 + 2]
+                    );
+                }
+
+                if (hasUV) {
+                    uvList[v] = glm::vec2(
+                            attribute.texcoords[index.texcoord_index * 2 + 0],
+                            attribute.texcoords[index.texcoord_index * 2 + 1]
+                    );
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threadList;
+
+    for (unsigned int t = 1; t < std::min<size_t>(threadCount, blockList.size()); t++) {
+        threadList.emplace_back(convert);
+    }
+
+    convert();
+
+    for (auto &thread : threadList) {
+        thread.join();
+    }
+}
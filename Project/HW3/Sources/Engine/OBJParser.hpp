@@ -0,0 +1,31 @@
+#ifndef ENGINE_OBJ_PARSER_HPP
+#define ENGINE_OBJ_PARSER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Turns an .obj file into de-indexed, triangulated attribute streams.
+    // The normal and uv lists are left empty if the file has none.
+    class OBJParser {
+    public:
+        // Use tinyobj::LoadObj() on the calling thread.
+        static const int SINGLE_THREAD = 0;
+        // Use one thread per core.
+        static const int ALL_THREADS = -1;
+
+        // threadCount: SINGLE_THREAD, ALL_THREADS or the number of threads.
+        // Other than SINGLE_THREAD, the file is memory-mapped and parsed with the threaded parser
+        // from tinyobjloader's experimental directory. (With at most one thread per MiB of the file.)
+        // Both paths give exactly the same streams. (HW3 --check-obj checks it.)
+        // Throws if the threaded parser fails. (The single-threaded one prints tinyobj's error instead.)
+        static void parse(
+                const std::string &path,
+                int threadCount,
+                std::vector<glm::vec3> &positionList,
+                std::vector<glm::vec3> &normalList,
+                std::vector<glm::vec2> &uvList
+        );
+    };
+}
+
+#endif
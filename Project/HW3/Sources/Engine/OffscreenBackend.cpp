@@ -0,0 +1,133 @@
+#include "Engine.hpp"
+
+#ifdef ENGINE_USE_EGL
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+// Mesa's surfaceless display if the client supports it, or the default one.
+static EGLDisplay getDisplay();
+#endif
+
+namespace Engine {
+#ifdef ENGINE_USE_EGL
+    OffscreenBackend::OffscreenBackend(int width, int height) : m_width(width), m_height(height) {
+        m_display = getDisplay();
+
+        if (m_display == EGL_NO_DISPLAY || !eglInitialize(m_display, nullptr, nullptr)) {
+            throw std::runtime_error("Error: Failed to initialize EGL.");
+        }
+
+        const EGLint configAttributeList[] = {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_DEPTH_SIZE, 24,
+                EGL_NONE
+        };
+
+        EGLConfig config;
+        EGLint configCount = 0;
+
+        if (!eglChooseConfig(m_display, configAttributeList, &config, 1, &configCount) || configCount == 0) {
+            eglTerminate(m_display);
+            throw std::runtime_error("Error: No EGL config for offscreen rendering.");
+        }
+
+        const EGLint surfaceAttributeList[] = {
+                EGL_WIDTH, width,
+                EGL_HEIGHT, height,
+                EGL_NONE
+        };
+
+        // Same version & profile as the window.
+        const EGLint contextAttributeList[] = {
+                EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+                EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT_KHR,
+                EGL_NONE
+        };
+
+        eglBindAPI(EGL_OPENGL_API);
+
+        m_surface = eglCreatePbufferSurface(m_display, config, surfaceAttributeList);
+        m_context = eglCreateContext(m_display, config, EGL_NO_CONTEXT, contextAttributeList);
+
+        if (m_surface == EGL_NO_SURFACE
+            || m_context == EGL_NO_CONTEXT
+            || !eglMakeCurrent(m_display, m_surface, m_surface, m_context)) {
+            eglTerminate(m_display);
+            throw std::runtime_error("Error: Failed to create the offscreen context.");
+        }
+
+        // Initialize GLEW.
+        glewExperimental = GL_TRUE;
+
+        if (glewInit() != GLEW_OK) {
+            eglTerminate(m_display);
+            throw std::runtime_error("Error: Failed to initialize GLEW.");
+        }
+
+        setContextCurrent(true);
+    }
+
+    OffscreenBackend::~OffscreenBackend() {
+        setContextCurrent(false);
+
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(m_display, m_context);
+        eglDestroySurface(m_display, m_surface);
+        eglTerminate(m_display);
+    }
+
+    void OffscreenBackend::present() {
+        // (Keeps the frames from piling up in the queue, like a swap does.)
+        glFinish();
+    }
+#else
+    OffscreenBackend::OffscreenBackend(int width, int height) : m_width(width), m_height(height) {
+        throw std::runtime_error("Error: Offscreen rendering needs a build with ENGINE_USE_EGL.");
+    }
+
+    OffscreenBackend::~OffscreenBackend() = default;
+
+    void OffscreenBackend::present() {
+    }
+#endif
+
+    bool OffscreenBackend::isClosed() const {
+        return false;
+    }
+
+    void OffscreenBackend::getFrameBufferSize(int &width, int &height) const {
+        width = m_width;
+        height = m_height;
+    }
+}
+
+#ifdef ENGINE_USE_EGL
+static EGLDisplay getDisplay() {
+    auto extensionList = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (extensionList != nullptr && std::strstr(extensionList, "EGL_MESA_platform_surfaceless") != nullptr) {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+                eglGetProcAddress("eglGetPlatformDisplayEXT")
+        );
+
+        if (getPlatformDisplay != nullptr) {
+            auto display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+#endif
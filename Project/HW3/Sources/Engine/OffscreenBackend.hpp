@@ -0,0 +1,39 @@
+#ifndef ENGINE_OFFSCREEN_BACKEND_HPP
+#define ENGINE_OFFSCREEN_BACKEND_HPP
+
+#include "Engine.hpp"
+
+#ifdef ENGINE_USE_EGL
+#include <EGL/egl.h>
+#endif
+
+namespace Engine {
+    // Renders into an EGL pbuffer of a fixed size, without a window or a display server.
+    // (Mesa's surfaceless platform is used if it's there, so software rasterizers like llvmpipe work.)
+    // Throws if the engine is built without ENGINE_USE_EGL.
+    class OffscreenBackend : public Backend {
+    public:
+        OffscreenBackend(int width, int height);
+        ~OffscreenBackend() override;
+
+        OffscreenBackend(const OffscreenBackend &) = delete;
+        OffscreenBackend &operator=(const OffscreenBackend &) = delete;
+
+        // Finish the frame. (Nothing to show.)
+        void present() override;
+        bool isClosed() const override;
+        void getFrameBufferSize(int &width, int &height) const override;
+
+    private:
+        int m_width;
+        int m_height;
+
+#ifdef ENGINE_USE_EGL
+        EGLDisplay m_display = EGL_NO_DISPLAY;
+        EGLSurface m_surface = EGL_NO_SURFACE;
+        EGLContext m_context = EGL_NO_CONTEXT;
+#endif
+    };
+}
+
+#endif
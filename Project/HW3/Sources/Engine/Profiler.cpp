@@ -0,0 +1,453 @@
+#include "Engine.hpp"
+
+// Quote the string for JSON.
+static std::string quoteJSON(const std::string &text) {
+    std::string result = "\"";
+
+    for (auto c: text) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+        }
+
+        result += c;
+    }
+
+    return result + "\"";
+}
+
+// Quote the string for CSV, if needed.
+static std::string quoteCSV(const std::string &text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+
+    std::string result = "\"";
+
+    for (auto c: text) {
+        if (c == '"') {
+            result += '"';
+        }
+
+        result += c;
+    }
+
+    return result + "\"";
+}
+
+namespace Engine {
+    Profiler::Scope::Scope(Profiler &profiler, const std::string &name) : m_profiler(profiler) {
+        m_profiler.beginScope(name);
+    }
+
+    Profiler::Scope::~Scope() {
+        m_profiler.endScope();
+    }
+
+    Profiler::Profiler(int frameCount) :
+            m_startTime(std::chrono::steady_clock::now()),
+            m_frameList(static_cast<size_t>(std::max(frameCount, QUERY_SET_COUNT))) {
+        for (auto &querySet: m_querySetList) {
+            querySet.queryCount = 0;
+            querySet.frameNumber = 0;
+        }
+    }
+
+    Profiler::~Profiler() {
+        // Nothing to free if the context is already gone.
+        if (!m_isQueryCreated || !Backend::isContextCurrent()) {
+            return;
+        }
+
+        for (auto &querySet: m_querySetList) {
+            glDeleteQueries(MAX_GPU_SCOPES, querySet.queryList);
+        }
+    }
+
+    void Profiler::beginFrame() {
+        endFrame();
+
+        if (!m_isQueryCreated) {
+            for (auto &querySet: m_querySetList) {
+                glGenQueries(MAX_GPU_SCOPES, querySet.queryList);
+            }
+
+            m_isQueryCreated = true;
+        }
+
+        // Reuse the query set of 2 frames ago. (Read its results first.)
+        auto &querySet = m_querySetList[m_frameCount % QUERY_SET_COUNT];
+
+        collect(querySet);
+        querySet.frameNumber = m_frameCount;
+
+        auto &frame = m_frameList[m_frameCount % m_frameList.size()];
+
+        frame.number = m_frameCount;
+        frame.start = getTime();
+        frame.cpuTime = 0.0;
+        frame.scopeList.clear();
+
+        m_frameCount++;
+        m_isInFrame = true;
+    }
+
+    void Profiler::endFrame() {
+        if (!m_isInFrame) {
+            return;
+        }
+
+        // Close the scopes which are still open.
+        while (!m_scopeStack.empty()) {
+            endScope();
+        }
+
+        auto &frame = m_frameList[(m_frameCount - 1) % m_frameList.size()];
+
+        frame.cpuTime = getTime() - frame.start;
+        m_isInFrame = false;
+    }
+
+    void Profiler::beginScope(const std::string &name) {
+        if (!m_isInFrame) {
+            return;
+        }
+
+        auto &frame = m_frameList[(m_frameCount - 1) % m_frameList.size()];
+        auto index = static_cast<int>(frame.scopeList.size());
+        auto depth = static_cast<int>(m_scopeStack.size());
+
+        frame.scopeList.push_back({getNameId(name), depth, getTime() - frame.start, 0.0, -1.0});
+        m_scopeStack.push_back(index);
+
+        // Only the outermost scopes are timed on the GPU. (The queries can't nest.)
+        auto &querySet = m_querySetList[(m_frameCount - 1) % QUERY_SET_COUNT];
+
+        if (depth == 0 && querySet.queryCount < MAX_GPU_SCOPES) {
+            glBeginQuery(GL_TIME_ELAPSED, querySet.queryList[querySet.queryCount]);
+            querySet.scopeIndexList[querySet.queryCount] = index;
+            m_isQueryActive = true;
+        }
+    }
+
+    void Profiler::endScope() {
+        if (!m_isInFrame) {
+            return;
+        }
+
+        if (m_scopeStack.empty()) {
+            throw std::runtime_error("Error: endScope() without beginScope().");
+        }
+
+        auto &frame = m_frameList[(m_frameCount - 1) % m_frameList.size()];
+        auto &scope = frame.scopeList[m_scopeStack.back()];
+
+        m_scopeStack.pop_back();
+        scope.cpuTime = getTime() - frame.start - scope.start;
+
+        if (scope.depth == 0 && m_isQueryActive) {
+            glEndQuery(GL_TIME_ELAPSED);
+            m_querySetList[(m_frameCount - 1) % QUERY_SET_COUNT].queryCount++;
+            m_isQueryActive = false;
+        }
+    }
+
+    Profiler::Stats Profiler::getFrameStats(Clock clock) const {
+        std::vector<double> sampleList;
+
+        for (auto &frame: m_frameList) {
+            if (findFrame(frame.number) != &frame) {
+                continue;
+            }
+
+            if (clock == CPU) {
+                sampleList.push_back(frame.cpuTime);
+                continue;
+            }
+
+            // Skip the frames with a missing GPU time.
+            double sum = 0.0;
+            bool isComplete = !frame.scopeList.empty();
+
+            for (auto &scope: frame.scopeList) {
+                if (scope.depth == 0) {
+                    isComplete = isComplete && scope.gpuTime >= 0.0;
+                    sum += scope.gpuTime;
+                }
+            }
+
+            if (isComplete) {
+                sampleList.push_back(sum);
+            }
+        }
+
+        return makeStats(sampleList);
+    }
+
+    Profiler::Stats Profiler::getScopeStats(const std::string &name, Clock clock) const {
+        std::vector<double> sampleList;
+        auto iterator = m_nameMap.find(name);
+
+        if (iterator == m_nameMap.end()) {
+            return makeStats(sampleList);
+        }
+
+        for (auto &frame: m_frameList) {
+            if (findFrame(frame.number) != &frame) {
+                continue;
+            }
+
+            double sum = 0.0;
+            bool isFound = false;
+            bool isComplete = true;
+
+            for (auto &scope: frame.scopeList) {
+                if (scope.nameId != iterator->second) {
+                    continue;
+                }
+
+                isFound = true;
+
+                if (clock == CPU) {
+                    sum += scope.cpuTime;
+                }
+                else {
+                    isComplete = isComplete && scope.gpuTime >= 0.0;
+                    sum += scope.gpuTime;
+                }
+            }
+
+            if (isFound && isComplete) {
+                sampleList.push_back(sum);
+            }
+        }
+
+        return makeStats(sampleList);
+    }
+
+    const std::vector<std::string> &Profiler::getScopeNames() const {
+        return m_nameList;
+    }
+
+    unsigned int Profiler::getDroppedCount() const {
+        return m_droppedCount;
+    }
+
+    void Profiler::printReport(std::ostream &stream) const {
+        auto flags = stream.flags();
+        auto precision = stream.precision();
+
+        auto printRow = [&stream](const std::string &label, const Stats &stats) {
+            stream << std::left << std::setw(20) << label << std::right << std::fixed << std::setprecision(3)
+                   << std::setw(10) << stats.average
+                   << std::setw(10) << stats.p50
+                   << std::setw(10) << stats.p95
+                   << std::setw(10) << stats.p99
+                   << std::setw(10) << stats.max
+                   << std::setw(8) << stats.sampleCount << "\n";
+        };
+
+        stream << std::left << std::setw(20) << "(ms)" << std::right
+               << std::setw(10) << "avg"
+               << std::setw(10) << "p50"
+               << std::setw(10) << "p95"
+               << std::setw(10) << "p99"
+               << std::setw(10) << "max"
+               << std::setw(8) << "frames" << "\n";
+
+        printRow("Frame CPU", getFrameStats(CPU));
+        printRow("Frame GPU", getFrameStats(GPU));
+
+        for (auto &name: m_nameList) {
+            printRow("  " + name + " CPU", getScopeStats(name, CPU));
+
+            // (The inner scopes have no GPU times.)
+            auto gpuStats = getScopeStats(name, GPU);
+
+            if (gpuStats.sampleCount > 0) {
+                printRow("  " + name + " GPU", gpuStats);
+            }
+        }
+
+        stream << "GPU results dropped: " << m_droppedCount << "\n";
+        stream.flags(flags);
+        stream.precision(precision);
+    }
+
+    void Profiler::exportTrace(const std::string &path) const {
+        std::ofstream file(path);
+
+        if (!file) {
+            throw std::runtime_error("Error: Failed to write " + path + ".");
+        }
+
+        // Times in microseconds.
+        file << std::fixed << std::setprecision(3)
+             << "{\"traceEvents\":[\n"
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"CPU\"}},\n"
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}";
+
+        auto writeEvent = [&file](const std::string &name, int thread, double start, double length) {
+            file << ",\n{\"name\":" << quoteJSON(name) << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+                 << ",\"ts\":" << start * 1000.0 << ",\"dur\":" << length * 1000.0 << "}";
+        };
+
+        for (uint64_t number = m_frameCount - std::min<uint64_t>(m_frameCount, m_frameList.size());
+             number < m_frameCount; number++) {
+            auto frame = findFrame(number);
+
+            if (frame == nullptr) {
+                continue;
+            }
+
+            writeEvent("Frame " + std::to_string(number), 1, frame->start, frame->cpuTime);
+
+            auto gpuStart = frame->start;
+
+            for (auto &scope: frame->scopeList) {
+                writeEvent(m_nameList[scope.nameId], 1, frame->start + scope.start, scope.cpuTime);
+
+                if (scope.gpuTime >= 0.0) {
+                    writeEvent(m_nameList[scope.nameId], 2, gpuStart, scope.gpuTime);
+                    gpuStart += scope.gpuTime;
+                }
+            }
+        }
+
+        file << "\n]}\n";
+    }
+
+    void Profiler::exportCSV(const std::string &path) const {
+        std::ofstream file(path);
+
+        if (!file) {
+            throw std::runtime_error("Error: Failed to write " + path + ".");
+        }
+
+        // The frame rows have the scope "Frame" and the depth 0. (The scopes start from 1.)
+        file << std::fixed << std::setprecision(4) << "frame,scope,depth,start_ms,cpu_ms,gpu_ms\n";
+
+        for (uint64_t number = m_frameCount - std::min<uint64_t>(m_frameCount, m_frameList.size());
+             number < m_frameCount; number++) {
+            auto frame = findFrame(number);
+
+            if (frame == nullptr) {
+                continue;
+            }
+
+            double gpuSum = 0.0;
+            bool isGPUComplete = !frame->scopeList.empty();
+
+            for (auto &scope: frame->scopeList) {
+                if (scope.depth == 0) {
+                    isGPUComplete = isGPUComplete && scope.gpuTime >= 0.0;
+                    gpuSum += scope.gpuTime;
+                }
+            }
+
+            file << number << ",Frame,0," << frame->start << "," << frame->cpuTime << ",";
+
+            if (isGPUComplete) {
+                file << gpuSum;
+            }
+
+            file << "\n";
+
+            for (auto &scope: frame->scopeList) {
+                file << number << "," << quoteCSV(m_nameList[scope.nameId]) << "," << scope.depth + 1 << ","
+                     << frame->start + scope.start << "," << scope.cpuTime << ",";
+
+                if (scope.gpuTime >= 0.0) {
+                    file << scope.gpuTime;
+                }
+
+                file << "\n";
+            }
+        }
+    }
+
+    double Profiler::getTime() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_startTime).count();
+    }
+
+    void Profiler::collect(QuerySet &querySet) {
+        auto frame = const_cast<Frame *>(findFrame(querySet.frameNumber));
+
+        for (int i = 0; i < querySet.queryCount; i++) {
+            GLint isAvailable = GL_FALSE;
+
+            // Don't wait for the GPU.
+            glGetQueryObjectiv(querySet.queryList[i], GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+
+            if (isAvailable == GL_FALSE) {
+                m_droppedCount++;
+                continue;
+            }
+
+            GLuint64 time = 0;
+
+            glGetQueryObjectui64v(querySet.queryList[i], GL_QUERY_RESULT, &time);
+
+            if (frame != nullptr) {
+                frame->scopeList[querySet.scopeIndexList[i]].gpuTime = static_cast<double>(time) / 1000000.0;
+            }
+        }
+
+        querySet.queryCount = 0;
+    }
+
+    int Profiler::getNameId(const std::string &name) {
+        auto iterator = m_nameMap.find(name);
+
+        if (iterator != m_nameMap.end()) {
+            return iterator->second;
+        }
+
+        auto nameId = static_cast<int>(m_nameList.size());
+
+        m_nameList.push_back(name);
+        m_nameMap[name] = nameId;
+
+        return nameId;
+    }
+
+    const Profiler::Frame *Profiler::findFrame(uint64_t number) const {
+        // Kept and finished. (The frame in progress is skipped.)
+        auto finishedCount = m_isInFrame ? m_frameCount - 1 : m_frameCount;
+
+        if (number >= finishedCount || m_frameCount - number > m_frameList.size()) {
+            return nullptr;
+        }
+
+        auto &frame = m_frameList[number % m_frameList.size()];
+
+        return frame.number == number ? &frame : nullptr;
+    }
+
+    Profiler::Stats Profiler::makeStats(std::vector<double> &sampleList) {
+        Stats stats = {static_cast<int>(sampleList.size()), 0.0, 0.0, 0.0, 0.0, 0.0};
+
+        if (sampleList.empty()) {
+            return stats;
+        }
+
+        std::sort(sampleList.begin(), sampleList.end());
+
+        // Nearest rank.
+        auto percentile = [&sampleList](double p) {
+            auto rank = static_cast<size_t>(std::ceil(p * sampleList.size()));
+            return sampleList[std::min(std::max(rank, static_cast<size_t>(1)), sampleList.size()) - 1];
+        };
+
+        for (auto sample: sampleList) {
+            stats.average += sample;
+        }
+
+        stats.average /= sampleList.size();
+        stats.p50 = percentile(0.50);
+        stats.p95 = percentile(0.95);
+        stats.p99 = percentile(0.99);
+        stats.max = sampleList.back();
+
+        return stats;
+    }
+}
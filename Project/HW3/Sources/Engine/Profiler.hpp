@@ -0,0 +1,141 @@
+#ifndef ENGINE_PROFILER_HPP
+#define ENGINE_PROFILER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Frame profiler. Keeps the CPU time of each frame and of the scopes in it, for the last N frames.
+    // The scopes nest. The outermost ones (the passes) are also timed on the GPU with GL_TIME_ELAPSED queries.
+    //
+    // The queries are double-buffered: The results of a frame are read 2 frames later, when its query set
+    // is reused. A result which isn't ready by then is dropped instead of waited for. (See getDroppedCount().)
+    class Profiler {
+    public:
+        enum Clock {
+            CPU,
+            GPU
+        };
+
+        // Statistics of the kept frames, in milliseconds. (All 0 if sampleCount == 0.)
+        struct Stats {
+            int sampleCount;
+            double average;
+            double p50;
+            double p95;
+            double p99;
+            double max;
+        };
+
+        // Times a scope until the end of the block.
+        class Scope {
+        public:
+            Scope(Profiler &profiler, const std::string &name);
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            Profiler &m_profiler;
+        };
+
+        explicit Profiler(int frameCount = 300);
+        ~Profiler();
+
+        Profiler(const Profiler &) = delete;
+        Profiler &operator=(const Profiler &) = delete;
+
+        // Mark the frame. (Renderer calls these around onDraw() and present().)
+        void beginFrame();
+        void endFrame();
+
+        // Time a scope. (Ignored outside of a frame.)
+        void beginScope(const std::string &name);
+        void endScope();
+
+        // Frame times. (CPU: beginFrame() ~ endFrame(), GPU: Sum of the outermost scopes.)
+        Stats getFrameStats(Clock clock = CPU) const;
+
+        // Times of the scope with the name, summed per frame. (Frames without it are skipped.)
+        Stats getScopeStats(const std::string &name, Clock clock = CPU) const;
+
+        // Names of the scopes seen so far, in order of appearance.
+        const std::vector<std::string> &getScopeNames() const;
+
+        // Number of the GPU results which weren't ready in time.
+        unsigned int getDroppedCount() const;
+
+        // Print a table of the frame & scope statistics.
+        void printReport(std::ostream &stream) const;
+
+        // Write the kept frames as a Chrome trace. (chrome://tracing, or https://ui.perfetto.dev)
+        // The GPU scopes are placed end to end from the start of their frame; only their lengths are measured.
+        void exportTrace(const std::string &path) const;
+
+        // Write the kept frames as CSV. (One row per frame and per scope. Missing GPU times are empty.)
+        void exportCSV(const std::string &path) const;
+
+    private:
+        // At most this many outermost scopes per frame are timed on the GPU.
+        static const int MAX_GPU_SCOPES = 16;
+        static const int QUERY_SET_COUNT = 2;
+
+        struct ScopeRecord {
+            int nameId;
+            int depth;
+            // Start from the start of the frame, and the lengths. (ms, gpuTime < 0 if not measured)
+            double start;
+            double cpuTime;
+            double gpuTime;
+        };
+
+        struct Frame {
+            uint64_t number = 0;
+            // Start from the creation of the profiler. (ms)
+            double start;
+            double cpuTime;
+            std::vector<ScopeRecord> scopeList;
+        };
+
+        struct QuerySet {
+            GLuint queryList[MAX_GPU_SCOPES];
+            // Scope of each query in the frame.
+            int scopeIndexList[MAX_GPU_SCOPES];
+            int queryCount;
+            uint64_t frameNumber;
+        };
+
+        double getTime() const;
+
+        // Read the results of the query set into its frame, if the frame is still kept.
+        void collect(QuerySet &querySet);
+
+        int getNameId(const std::string &name);
+
+        const Frame *findFrame(uint64_t number) const;
+
+        static Stats makeStats(std::vector<double> &sampleList);
+
+        std::chrono::steady_clock::time_point m_startTime;
+
+        // Ring of the last frames. (m_frameCount frames were begun so far.)
+        std::vector<Frame> m_frameList;
+        uint64_t m_frameCount = 0;
+        bool m_isInFrame = false;
+
+        // Scopes open in the current frame.
+        std::vector<int> m_scopeStack;
+
+        std::vector<std::string> m_nameList;
+        std::map<std::string, int> m_nameMap;
+
+        // (Created at the first frame, since the context may not exist before it.)
+        QuerySet m_querySetList[QUERY_SET_COUNT];
+        bool m_isQueryCreated = false;
+        bool m_isQueryActive = false;
+
+        unsigned int m_droppedCount = 0;
+    };
+}
+
+#endif
@@ -1,15 +1,125 @@
 #include "Engine.hpp"
 
+static bool isCompatible(GLenum uniformType, GLenum valueType);
+
 namespace Engine {
     Program::Program(std::initializer_list<Engine::Shader *> shaderList) {
+        static const bool isCacheSupported = ProgramCache::isSupported();
+
+        std::vector<const Shader *> cacheShaderList(shaderList.begin(), shaderList.end());
+        auto key = isCacheSupported ? ProgramCache::makeKey(cacheShaderList) : 0;
+        auto cachePath = isCacheSupported ? ProgramCache::getCachePath(cacheShaderList) : std::string();
+        auto isLoaded = false;
+
         // Create a program.
         m_id = glCreateProgram();
 
+        // Load the binary of the last run. (The driver may still reject it, e.g. after an update.)
+        if (isCacheSupported) {
+            auto cache = ProgramCache::load(cachePath, key);
+
+            if (cache != nullptr) {
+                GLint result;
+
+                glProgramBinary(m_id, cache->getFormat(), cache->getData(), cache->getSize());
+                glGetProgramiv(m_id, GL_LINK_STATUS, &result);
+
+                isLoaded = result == GL_TRUE;
+            }
+        }
+
+        if (!isLoaded) {
+            link(shaderList, isCacheSupported);
+
+            if (isCacheSupported) {
+                ProgramCache::save(cachePath, key, m_id);
+            }
+        }
+
+        // Connect the shared uniform blocks. (GLSL 3.30 has no layout(binding = ...).)
+        UniformBuffer::bindBlocks(m_id);
+
+        reflectUniforms();
+    }
+
+    void Program::use() {
+        GLState::useProgram(getId());
+    }
+
+    void Program::setUniform(const UniformHandle<GLint> &handle, GLint value) {
+        auto location = prepareUpload(handle.getId(), &value, sizeof(value), GL_INT);
+
+        if (location >= 0) {
+            glUniform1i(location, value);
+        }
+    }
+
+    void Program::setUniform(const UniformHandle<GLfloat> &handle, GLfloat value) {
+        auto location = prepareUpload(handle.getId(), &value, sizeof(value), GL_FLOAT);
+
+        if (location >= 0) {
+            glUniform1f(location, value);
+        }
+    }
+
+    void Program::setUniform(const UniformHandle<glm::vec3> &handle, const glm::vec3 &value) {
+        auto location = prepareUpload(handle.getId(), &(value[0]), sizeof(value), GL_FLOAT_VEC3);
+
+        if (location >= 0) {
+            glUniform3fv(location, 1, &(value[0]));
+        }
+    }
+
+    void Program::setUniform(const UniformHandle<glm::mat4> &handle, const glm::mat4 &value) {
+        auto location = prepareUpload(handle.getId(), &(value[0][0]), sizeof(value), GL_FLOAT_MAT4);
+
+        if (location >= 0) {
+            glUniformMatrix4fv(location, 1, GL_FALSE, &(value[0][0]));
+        }
+    }
+
+    GLuint Program::getId() const {
+        return m_id;
+    }
+
+    const std::vector<Program::Uniform> &Program::getUniformList() const {
+        return m_uniformList;
+    }
+
+    int Program::getUniformId(const std::string &name) {
+        static std::map<std::string, int> idMap;
+
+        auto it = idMap.find(name);
+
+        if (it != idMap.end()) {
+            return it->second;
+        }
+
+        auto id = static_cast<int>(idMap.size());
+
+        idMap[name] = id;
+        return id;
+    }
+
+    void Program::link(std::initializer_list<Shader *> shaderList, bool isRetrievable) {
+        // Start all the compiles before waiting for any, so that the driver can run them in parallel.
+        for (auto &it : shaderList) {
+            it->compile();
+        }
+
+        for (auto &it : shaderList) {
+            it->check();
+        }
+
         // Link the shaders.
         for (auto &it : shaderList) {
             glAttachShader(m_id, it->getId());
         }
 
+        if (isRetrievable) {
+            glProgramParameteri(m_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
         glLinkProgram(m_id);
 
         for (auto &it : shaderList) {
@@ -20,53 +130,141 @@ namespace Engine {
         GLint result;
         GLint logLength;
 
-        glGetProgramiv(m_id, GL_COMPILE_STATUS, &result);
-        glGetProgramiv(m_id, GL_INFO_LOG_LENGTH, &logLength);
+        glGetProgramiv(m_id, GL_LINK_STATUS, &result);
+
+        if (result != GL_TRUE) {
+            glGetProgramiv(m_id, GL_INFO_LOG_LENGTH, &logLength);
 
-        if (logLength > 1) {
-            std::vector<char> log(static_cast<unsigned>(logLength + 1));
+            std::vector<char> log(static_cast<unsigned>(std::max(logLength, 0) + 1));
 
             glGetProgramInfoLog(m_id, logLength, nullptr, log.data());
 
-            throw std::runtime_error(log.data());
+            throw std::runtime_error(std::string("Error: Failed to link the program.\n") + log.data());
         }
     }
 
-    void Program::use() {
-        glUseProgram(getId());
-    }
+    void Program::reflectUniforms() {
+        GLint count = 0;
+        GLint maxNameLength = 0;
 
-    void Program::setUniform(const std::string &name, GLint value) {
-        glUniform1i(getUniformLocation(name), value);
-    }
+        glGetProgramiv(m_id, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(m_id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
 
-    void Program::setUniform(const std::string &name, GLfloat value) {
-        glUniform1f(getUniformLocation(name), value);
-    }
+        std::vector<char> nameBuffer(static_cast<size_t>(maxNameLength + 1));
+        std::vector<std::pair<int, int>> idSlotList;
 
-    void Program::setUniform(const std::string &name, const glm::vec3 &value) {
-        glUniform3fv(getUniformLocation(name), 1, &(value[0]));
-    }
+        m_uniformList.clear();
 
-    void Program::setUniform(const std::string &name, const glm::mat4 &value) {
-        glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, &(value[0][0]));
-    }
+        for (GLint i = 0; i < count; i++) {
+            GLint size = 0;
+            GLenum type = 0;
 
-    GLuint Program::getId() const {
-        return m_id;
+            glGetActiveUniform(
+                    m_id,
+                    static_cast<GLuint>(i),
+                    static_cast<GLsizei>(nameBuffer.size()),
+                    nullptr,
+                    &size,
+                    &type,
+                    nameBuffer.data()
+            );
+
+            std::string name = nameBuffer.data();
+
+            // Arrays are reported as "name[0]". Register every element.
+            std::string baseName = name;
+            bool isArray = false;
+
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+                baseName = name.substr(0, name.size() - 3);
+                isArray = true;
+            }
+
+            for (GLint j = 0; j < size; j++) {
+                std::string elementName = isArray ? baseName + "[" + std::to_string(j) + "]" : name;
+                auto location = glGetUniformLocation(m_id, elementName.c_str());
+
+                // (Members of the uniform blocks have no location.)
+                if (location < 0) {
+                    continue;
+                }
+
+                Uniform uniform;
+
+                uniform.name = elementName;
+                uniform.type = type;
+                uniform.location = location;
+                uniform.isSet = false;
+                std::memset(uniform.value, 0, sizeof(uniform.value));
+
+                auto slot = static_cast<int>(m_uniformList.size());
+
+                m_uniformList.emplace_back(uniform);
+                idSlotList.emplace_back(getUniformId(elementName), slot);
+
+                // "name" also refers to "name[0]".
+                if (isArray && j == 0) {
+                    idSlotList.emplace_back(getUniformId(baseName), slot);
+                }
+            }
+        }
+
+        // Flat table: Uniform id -> Slot.
+        int maxId = -1;
+
+        for (auto &idSlot: idSlotList) {
+            maxId = std::max(maxId, idSlot.first);
+        }
+
+        m_slotList.assign(static_cast<size_t>(maxId + 1), -1);
+
+        for (auto &idSlot: idSlotList) {
+            m_slotList[idSlot.first] = idSlot.second;
+        }
     }
 
-    GLint Program::getUniformLocation(const std::string &name) {
-        GLint location;
+    GLint Program::prepareUpload(int id, const void *data, size_t size, GLenum type) {
+        if (id < 0 || id >= static_cast<int>(m_slotList.size()) || m_slotList[id] < 0) {
+            return -1;
+        }
+
+        auto &uniform = m_uniformList[m_slotList[id]];
 
-        if (m_uniformCache.count(name) == 0) {
-            location = glGetUniformLocation(getId(), name.c_str());
-            m_uniformCache[name] = location;
+        if (uniform.isSet && std::memcmp(uniform.value, data, size) == 0) {
+            return -1;
         }
-        else {
-            location = m_uniformCache[name];
+
+        if (!isCompatible(uniform.type, type)) {
+            throw std::runtime_error("Error: Uniform " + uniform.name + " has a different type.");
         }
 
-        return location;
+        std::memcpy(uniform.value, data, size);
+        uniform.isSet = true;
+
+        return uniform.location;
     }
 }
+
+static bool isCompatible(GLenum uniformType, GLenum valueType) {
+    if (uniformType == valueType) {
+        return true;
+    }
+
+    // Booleans and samplers are set with integers.
+    if (valueType == GL_INT) {
+        switch (uniformType) {
+        case GL_BOOL:
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_1D_SHADOW:
+        case GL_SAMPLER_2D_SHADOW:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    return false;
+}
@@ -2,28 +2,61 @@
 #define ENGINE_PROGRAM_HPP
 
 namespace Engine {
+    template<typename T>
+    class UniformHandle;
+
     // Program object.
     class Program {
     public:
+        // Active uniform found at link time. (glGetActiveUniform)
+        struct Uniform {
+            std::string name;
+            GLenum type;
+            GLint location;
+
+            // Last uploaded value. (Uploading the same value again is skipped.)
+            bool isSet;
+            unsigned char value[sizeof(glm::mat4)];
+        };
+
+        // Loads the program from its ProgramCache if it can, otherwise compiles & links the shaders and caches it.
         explicit Program(std::initializer_list<Shader *> shaderList);
 
         // Use(glUseProgram) the program.
         void use();
 
-        // Set the value of the uniform in the shaders.
-        void setUniform(const std::string &name, GLint value);
-        void setUniform(const std::string &name, GLfloat value);
-        void setUniform(const std::string &name, const glm::vec3 &value);
-        void setUniform(const std::string &name, const glm::mat4 &value);
+        // Set the value of the uniform in the shaders. (The program must be in use.)
+        // Does nothing if the program has no such uniform or the value didn't change.
+        void setUniform(const UniformHandle<GLint> &handle, GLint value);
+        void setUniform(const UniformHandle<GLfloat> &handle, GLfloat value);
+        void setUniform(const UniformHandle<glm::vec3> &handle, const glm::vec3 &value);
+        void setUniform(const UniformHandle<glm::mat4> &handle, const glm::mat4 &value);
 
         GLuint getId() const;
 
+        // Active uniforms of the program. (Array elements are listed one by one.)
+        const std::vector<Uniform> &getUniformList() const;
+
+        // Id of the uniform name, shared by all programs. (See UniformHandle.)
+        static int getUniformId(const std::string &name);
+
     private:
-        GLint getUniformLocation(const std::string &name);
+        // Compile the shaders and link them. Throws with the info log if either fails.
+        // (isRetrievable: Keep the binary for glGetProgramBinary().)
+        void link(std::initializer_list<Shader *> shaderList, bool isRetrievable);
+
+        // Read the active uniforms and fill m_uniformList & m_slotList.
+        void reflectUniforms();
+
+        // Find the uniform and update its shadow copy.
+        // Returns the location to upload to, or -1 if we can skip the upload.
+        GLint prepareUpload(int id, const void *data, size_t size, GLenum type);
 
         GLuint m_id;
 
-        std::map<std::string, GLint> m_uniformCache;
+        std::vector<Uniform> m_uniformList;
+        // Uniform id -> Index in m_uniformList. (-1 if not active in this program.)
+        std::vector<int> m_slotList;
     };
 }
 
@@ -0,0 +1,133 @@
+#include "Engine.hpp"
+
+static const char MAGIC[4] = {'C', 'G', 'L', 'P'};
+
+static std::string getGLString(GLenum name);
+
+namespace Engine {
+    bool ProgramCache::isSupported() {
+        // (Core since 4.1. Through GL_ARB_get_program_binary before that, if at all.)
+        if (glGetProgramBinary == nullptr || glProgramBinary == nullptr) {
+            return false;
+        }
+
+        GLint formatCount = 0;
+
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+
+        return formatCount > 0;
+    }
+
+    uint64_t ProgramCache::makeKey(const std::vector<const Shader *> &shaderList) {
+        auto key = hashString(getGLString(GL_VENDOR) + "\n" + getGLString(GL_RENDERER) + "\n" + getGLString(GL_VERSION));
+
+        for (auto shader: shaderList) {
+            auto type = static_cast<uint32_t>(shader->getType());
+
+            key = hashBytes(&type, sizeof(type), key);
+            key = hashString(shader->getSource(), key);
+        }
+
+        return key;
+    }
+
+    std::string ProgramCache::getCachePath(const std::vector<const Shader *> &shaderList) {
+        std::string identity;
+
+        for (auto shader: shaderList) {
+            identity += shader->getPath() + "\n";
+
+            for (auto &define: shader->getDefineList()) {
+                identity += define + "\n";
+            }
+
+            identity += "\n";
+        }
+
+        std::stringstream pathStream;
+
+        pathStream << shaderList.front()->getPath() << "."
+                   << std::hex << std::setw(16) << std::setfill('0') << hashString(identity)
+                   << ".program";
+
+        return pathStream.str();
+    }
+
+    std::unique_ptr<ProgramCache> ProgramCache::load(const std::string &cachePath, uint64_t key) {
+        std::unique_ptr<MappedFile> file;
+
+        try {
+            file.reset(new MappedFile(cachePath));
+        }
+        catch (const std::runtime_error &) {
+            return nullptr;
+        }
+
+        if (file->getSize() < sizeof(Header)) {
+            return nullptr;
+        }
+
+        auto header = reinterpret_cast<const Header *>(file->getData());
+
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+            || header->version != VERSION
+            || header->key != key
+            || file->getSize() != sizeof(Header) + header->size) {
+            return nullptr;
+        }
+
+        return std::unique_ptr<ProgramCache>(new ProgramCache(std::move(file)));
+    }
+
+    void ProgramCache::save(const std::string &cachePath, uint64_t key, GLuint programId) {
+        GLint size = 0;
+
+        glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &size);
+
+        if (size <= 0) {
+            return;
+        }
+
+        std::vector<char> binary(static_cast<size_t>(size));
+        GLenum format = 0;
+
+        glGetProgramBinary(programId, size, &size, &format, binary.data());
+
+        Header header{};
+
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.key = key;
+        header.format = format;
+        header.size = static_cast<uint32_t>(size);
+
+        MappedFile::writeAtomically(cachePath, {
+                {&header, sizeof(Header)},
+                {binary.data(), static_cast<size_t>(size)}
+        });
+    }
+
+    GLenum ProgramCache::getFormat() const {
+        return static_cast<GLenum>(getHeader()->format);
+    }
+
+    const GLvoid *ProgramCache::getData() const {
+        return m_file->getData() + sizeof(Header);
+    }
+
+    GLsizei ProgramCache::getSize() const {
+        return static_cast<GLsizei>(getHeader()->size);
+    }
+
+    ProgramCache::ProgramCache(std::unique_ptr<MappedFile> file) : m_file(std::move(file)) {}
+
+    const ProgramCache::Header *ProgramCache::getHeader() const {
+        return reinterpret_cast<const Header *>(m_file->getData());
+    }
+}
+
+static std::string getGLString(GLenum name) {
+    auto value = reinterpret_cast<const char *>(glGetString(name));
+
+    return value != nullptr ? value : "";
+}
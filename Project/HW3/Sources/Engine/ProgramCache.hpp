@@ -0,0 +1,53 @@
+#ifndef ENGINE_PROGRAM_CACHE_HPP
+#define ENGINE_PROGRAM_CACHE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Linked program binary (glGetProgramBinary), stored next to the program's first shader.
+    // The cache is keyed by the sources of all the stages and by the driver, since a binary only loads
+    // on the driver which made it. It is memory-mapped on load and handed to glProgramBinary() as is.
+    class ProgramCache {
+    public:
+        // Bump this whenever the layout of the file changes.
+        static const uint32_t VERSION = 1;
+
+        // Whether the driver can save & load program binaries at all. (Needs a current context.)
+        static bool isSupported();
+
+        // Hash of the stage sources (with their #defines) and of the driver's vendor, renderer & version strings.
+        static uint64_t makeKey(const std::vector<const Shader *> &shaderList);
+
+        // One file per set of stages. (Paths & #defines. A changed source overwrites its old binary.)
+        static std::string getCachePath(const std::vector<const Shader *> &shaderList);
+
+        // Map the cache. Returns nullptr if the cache is missing, broken or has another key.
+        static std::unique_ptr<ProgramCache> load(const std::string &cachePath, uint64_t key);
+
+        // Write the binary of the linked program. Failure is not fatal: We just compile again next time.
+        static void save(const std::string &cachePath, uint64_t key, GLuint programId);
+
+        GLenum getFormat() const;
+
+        // Pointer into the mapping. Valid while this object is alive.
+        const GLvoid *getData() const;
+        GLsizei getSize() const;
+
+    private:
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint64_t key;
+            uint32_t format;
+            uint32_t size;
+        };
+
+        explicit ProgramCache(std::unique_ptr<MappedFile> file);
+
+        const Header *getHeader() const;
+
+        std::unique_ptr<MappedFile> m_file;
+    };
+}
+
+#endif
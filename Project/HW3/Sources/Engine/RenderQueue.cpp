@@ -0,0 +1,198 @@
+#include "Engine.hpp"
+
+static const int PASS_BITS = 4;
+static const int STATE_BITS = 12;
+static const int DEPTH_BITS = 24;
+
+static uint64_t toField(GLuint value, int bits);
+
+namespace Engine {
+    void RenderQueue::setViewPoint(const glm::vec3 &position, float farDistance) {
+        m_viewPosition = position;
+        m_farDistance = std::max(farDistance, 1e-6f);
+    }
+
+    void RenderQueue::submit(Pass pass, Model *model, Program *program) {
+        auto center = glm::vec3(model->getModelMatrix()[3]);
+        auto depth = glm::distance(center, m_viewPosition) / m_farDistance;
+
+        Packet packet;
+
+        packet.key = makeKey(pass, program->getId(), model->getTextureId(), model->getVertexArrayId(), depth);
+        packet.model = model;
+        packet.program = program;
+
+        m_packetList.emplace_back(packet);
+        m_isSorted = false;
+    }
+
+    void RenderQueue::submitVisible(Pass pass, Program *program, const Frustum &frustum) {
+        auto count = m_cullModelList.size();
+
+        m_cullBoundsList.resize(count);
+        m_cullSphereList.resize(count);
+        m_cullVisibleList.resize(count);
+
+        for (size_t i = 0; i < count; i++) {
+            auto &bounds = m_cullBoundsList[i];
+
+            bounds = m_cullModelList[i]->getBounds();
+
+            // (An infinite radius passes every plane, so the models without bounds are always drawn.)
+            m_cullSphereList[i] = glm::vec4(
+                    bounds.center,
+                    bounds.isEmpty ? std::numeric_limits<float>::infinity() : bounds.radius
+            );
+        }
+
+        frustum.testSpheres(m_cullSphereList.data(), count, m_cullVisibleList.data());
+
+        for (size_t i = 0; i < count; i++) {
+            auto &bounds = m_cullBoundsList[i];
+            auto isVisible = m_cullVisibleList[i] != 0
+                             && (bounds.isEmpty || frustum.testBox(bounds.min, bounds.max));
+
+            if (isVisible) {
+                submit(pass, m_cullModelList[i], program);
+                m_drawnCountList[pass]++;
+            }
+            else {
+                m_culledCountList[pass]++;
+            }
+        }
+    }
+
+    void RenderQueue::submit(
+            Pass pass,
+            const SceneTree &sceneTree,
+            uint32_t groupMask,
+            Program *program,
+            const Frustum &frustum
+    ) {
+        m_cullProxyList.clear();
+        sceneTree.queryFrustum(frustum, groupMask, m_cullProxyList);
+
+        for (auto proxyId: m_cullProxyList) {
+            submit(pass, sceneTree.getModel(proxyId), program);
+        }
+
+        auto drawnCount = static_cast<unsigned int>(m_cullProxyList.size());
+
+        m_drawnCountList[pass] += drawnCount;
+        m_culledCountList[pass] += static_cast<unsigned int>(sceneTree.getCount(groupMask)) - drawnCount;
+    }
+
+    void RenderQueue::sort() {
+        if (m_isSorted) {
+            return;
+        }
+
+        auto count = m_packetList.size();
+
+        m_scratchList.resize(count);
+
+        // One pass per byte, from the lowest. (Stable, so the higher bytes decide at the end.)
+        for (int shift = 0; shift < 64; shift += 8) {
+            size_t countList[256] = {0};
+
+            for (auto &packet: m_packetList) {
+                countList[(packet.key >> shift) & 0xFF]++;
+            }
+
+            // Skip the byte if all the keys have the same value in it.
+            if (countList[(m_packetList[0].key >> shift) & 0xFF] == count) {
+                continue;
+            }
+
+            size_t offset = 0;
+
+            for (auto &bucketCount: countList) {
+                auto bucketSize = bucketCount;
+
+                bucketCount = offset;
+                offset += bucketSize;
+            }
+
+            for (auto &packet: m_packetList) {
+                m_scratchList[countList[(packet.key >> shift) & 0xFF]++] = packet;
+            }
+
+            m_packetList.swap(m_scratchList);
+        }
+
+        m_isSorted = true;
+    }
+
+    void RenderQueue::draw(Pass pass) {
+        if (!m_isSorted) {
+            throw std::runtime_error("Error: Render queue is not sorted.");
+        }
+
+        // Packets of a pass are contiguous after sorting.
+        auto passKey = static_cast<uint64_t>(pass);
+        auto begin = std::lower_bound(
+                m_packetList.begin(),
+                m_packetList.end(),
+                passKey,
+                [](const Packet &packet, uint64_t key) {
+                    return (packet.key >> (64 - PASS_BITS)) < key;
+                }
+        );
+
+        for (auto it = begin; it != m_packetList.end() && (it->key >> (64 - PASS_BITS)) == passKey; ++it) {
+            it->model->setProgram(it->program);
+            it->model->draw();
+        }
+    }
+
+    void RenderQueue::clear() {
+        m_packetList.clear();
+        m_isSorted = true;
+
+        std::fill(std::begin(m_drawnCountList), std::end(m_drawnCountList), 0u);
+        std::fill(std::begin(m_culledCountList), std::end(m_culledCountList), 0u);
+    }
+
+    const std::vector<RenderQueue::Packet> &RenderQueue::getPacketList() const {
+        return m_packetList;
+    }
+
+    unsigned int RenderQueue::getDrawnCount(Pass pass) const {
+        return m_drawnCountList[pass];
+    }
+
+    unsigned int RenderQueue::getCulledCount(Pass pass) const {
+        return m_culledCountList[pass];
+    }
+
+    uint64_t RenderQueue::makeKey(
+            Pass pass,
+            GLuint programId,
+            GLuint textureId,
+            GLuint vertexArrayId,
+            float depth
+    ) {
+        auto maxDepth = static_cast<float>((1u << DEPTH_BITS) - 1);
+        auto depthField = static_cast<uint64_t>(glm::clamp(depth, 0.0f, 1.0f) * maxDepth);
+
+        uint64_t stateField = (toField(programId, STATE_BITS) << (2 * STATE_BITS))
+                              | (toField(textureId, STATE_BITS) << STATE_BITS)
+                              | toField(vertexArrayId, STATE_BITS);
+
+        uint64_t key = static_cast<uint64_t>(pass) << (64 - PASS_BITS);
+
+        if (pass == OPAQUE) {
+            key |= (depthField << (3 * STATE_BITS)) | stateField;
+        }
+        else {
+            key |= (stateField << DEPTH_BITS) | depthField;
+        }
+
+        return key;
+    }
+}
+
+static uint64_t toField(GLuint value, int bits) {
+    // (GL names are small numbers, so the low bits tell the objects apart.)
+    return static_cast<uint64_t>(value) & ((1ULL << bits) - 1);
+}
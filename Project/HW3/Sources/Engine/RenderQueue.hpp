@@ -0,0 +1,84 @@
+#ifndef ENGINE_RENDER_QUEUE_HPP
+#define ENGINE_RENDER_QUEUE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Queue of draw packets, sorted by 64-bit keys before drawing.
+    // Submit the models of all passes, call sort() once, then draw() each pass and clear().
+    //
+    // Key layout (from the highest bit):
+    // - SHADOW : Pass(4) | Program(12) | Texture(12) | VAO(12) | Depth(24)  (Grouped by state)
+    // - OPAQUE : Pass(4) | Depth(24) | Program(12) | Texture(12) | VAO(12)  (Front to back)
+    class RenderQueue {
+    public:
+        enum Pass {
+            SHADOW = 0,
+            OPAQUE = 1,
+            PASS_COUNT
+        };
+
+        struct Packet {
+            uint64_t key;
+            Model *model;
+            Program *program;
+        };
+
+        // Set the point where the depth is measured from, and the distance which maps to the largest depth.
+        void setViewPoint(const glm::vec3 &position, float farDistance);
+
+        // Add a draw of the model with the program.
+        void submit(Pass pass, Model *model, Program *program);
+
+        // Add the draws of the models which are inside the frustum. (Sphere test in a batch, then a box test.)
+        template<typename T>
+        void submit(Pass pass, const std::vector<T *> &modelList, Program *program, const Frustum &frustum) {
+            m_cullModelList.assign(modelList.begin(), modelList.end());
+            submitVisible(pass, program, frustum);
+        }
+
+        // Add the draws of the proxies (with any of the bits in groupMask) which the scene tree finds in the frustum.
+        void submit(Pass pass, const SceneTree &sceneTree, uint32_t groupMask, Program *program, const Frustum &frustum);
+
+        // Sort all the packets by their keys. (LSD radix sort)
+        void sort();
+
+        // Draw the packets of the pass in order. (Call sort() first.)
+        void draw(Pass pass);
+
+        // Remove all the packets.
+        void clear();
+
+        const std::vector<Packet> &getPacketList() const;
+
+        // Number of the models the pass drew or culled since the last clear().
+        unsigned int getDrawnCount(Pass pass) const;
+        unsigned int getCulledCount(Pass pass) const;
+
+        // Build the key of a packet. (depth is in [0, 1].)
+        static uint64_t makeKey(Pass pass, GLuint programId, GLuint textureId, GLuint vertexArrayId, float depth);
+
+    private:
+        // Cull m_cullModelList and submit the rest.
+        void submitVisible(Pass pass, Program *program, const Frustum &frustum);
+
+        std::vector<Packet> m_packetList;
+        std::vector<Packet> m_scratchList;
+
+        // Scratch lists of the culling.
+        std::vector<Model *> m_cullModelList;
+        std::vector<Bounds> m_cullBoundsList;
+        std::vector<glm::vec4> m_cullSphereList;
+        std::vector<uint8_t> m_cullVisibleList;
+        std::vector<int> m_cullProxyList;
+
+        unsigned int m_drawnCountList[PASS_COUNT] = {0};
+        unsigned int m_culledCountList[PASS_COUNT] = {0};
+
+        glm::vec3 m_viewPosition;
+        float m_farDistance = 1.0f;
+        bool m_isSorted = true;
+    };
+}
+
+#endif
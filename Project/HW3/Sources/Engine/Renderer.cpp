@@ -3,66 +3,271 @@
 // Map for finding Renderer from GLFWwindow.
 static std::map<GLFWwindow *, Engine::Renderer *> windowMap;
 
+// Longest time a frame can advance the simulation. (After a stall, skip the time instead of catching up.)
+static const double MAX_FRAME_TIME = 0.25;
+
 namespace Engine {
-    Renderer::Renderer(int width, int height, const std::string &title)
+    Renderer::Renderer(int width, int height, const std::string &title, Backend::Type backendType)
             : m_windowWidth(width), m_windowHeight(height), m_title(title) {
-        // Initialize GLFW.
-        if (!glfwInit()) {
-            throw std::runtime_error("Error: Failed to initialize GLFW.");
+        // Create the context.
+        if (backendType == Backend::OFFSCREEN) {
+            m_backend.reset(new OffscreenBackend(width, height));
+        }
+        else {
+            m_backend.reset(new WindowBackend(width, height, m_title));
         }
 
-        glfwWindowHint(GLFW_SAMPLES, 4);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        m_window = m_backend->getWindow();
 
-        // Create the window.
-        m_window = glfwCreateWindow(m_windowWidth, m_windowHeight, m_title.c_str(), nullptr, nullptr);
-        windowMap[m_window] = this;
+        // Set the callbacks.
+        if (m_window != nullptr) {
+            windowMap[m_window] = this;
 
+            glfwSetWindowSizeCallback(m_window, Renderer::windowSizeCallback);
+            glfwSetMouseButtonCallback(m_window, Renderer::mouseButtonCallback);
+            glfwSetCursorPosCallback(m_window, Renderer::cursorPosCallback);
+            glfwSetKeyCallback(m_window, Renderer::keyCallback);
+        }
+
+        // Set the size of the frame buffer.
+        m_backend->getFrameBufferSize(m_frameBufferWidth, m_frameBufferHeight);
+    }
+
+    void Renderer::run() {
         if (m_window == nullptr) {
-            glfwTerminate();
-            throw std::runtime_error("Error: Failed to create the window.");
+            throw std::runtime_error("Error: run() needs a window. Use renderFrames() for offscreen rendering.");
         }
 
-        glfwMakeContextCurrent(m_window);
+        start();
+        startUpdateThread();
+
+        // Render until ESCAPE key or X button is pressed.
+        try {
+            do {
+                renderFrame();
+            } while (!m_backend->isClosed());
+        }
+        catch (...) {
+            stopUpdateThread();
+            throw;
+        }
 
-        // Initialize GLEW.
-        glewExperimental = GL_TRUE;
+        stopUpdateThread();
 
-        if (glewInit() != GLEW_OK) {
-            throw std::runtime_error("Error: Failed to initialize GLEW.");
+        // Close the window.
+        windowMap.erase(m_window);
+        m_window = nullptr;
+        m_backend.reset();
+    }
+
+    void Renderer::renderFrames(int count) {
+        if (!m_backend) {
+            throw std::runtime_error("Error: The renderer is already closed.");
         }
 
-        // Set the callbacks.
-        glfwSetInputMode(m_window, GLFW_STICKY_KEYS, GL_TRUE);
-        glfwSetWindowSizeCallback(m_window, Renderer::windowSizeCallback);
-        glfwSetMouseButtonCallback(m_window, Renderer::mouseButtonCallback);
-        glfwSetCursorPosCallback(m_window, Renderer::cursorPosCallback);
-        glfwSetKeyCallback(m_window, Renderer::keyCallback);
+        start();
+        startUpdateThread();
 
-        // Set the size of the frame buffer.
-        glfwGetFramebufferSize(
-                m_window,
-                &m_frameBufferWidth,
-                &m_frameBufferHeight
-        );
+        try {
+            for (int i = 0; i < count; i++) {
+                renderFrame();
+            }
+        }
+        catch (...) {
+            stopUpdateThread();
+            throw;
+        }
+
+        stopUpdateThread();
     }
 
-    void Renderer::run() {
+    Profiler &Renderer::getProfiler() {
+        return m_profiler;
+    }
+
+    void Renderer::setUpdateRate(double rate) {
+        if (rate <= 0.0) {
+            throw std::runtime_error("Error: The update rate must be positive.");
+        }
+
+        m_updateStep = 1.0 / rate;
+    }
+
+    void Renderer::setSwapInterval(int interval) {
+        if (m_backend) {
+            m_backend->setSwapInterval(interval);
+        }
+    }
+
+    void Renderer::setFrameLimit(double rate) {
+        m_framePeriod = rate > 0.0 ? 1.0 / rate : 0.0;
+    }
+
+    void Renderer::setFixedFrameTime(double seconds) {
+        m_fixedFrameTime = std::max(seconds, 0.0);
+    }
+
+    void Renderer::setThreadedUpdate(bool isThreaded) {
+        if (m_updateThread.joinable()) {
+            throw std::runtime_error("Error: Can't change the update thread while rendering.");
+        }
+
+        m_isUpdateThreaded = isThreaded;
+    }
+
+    float Renderer::getInterpolation() const {
+        return m_interpolation;
+    }
+
+    float Renderer::getInterpolation(double stepTime) const {
+        auto drawTime = m_drawTime;
+
+        if (m_isUpdateThreaded) {
+            auto now = std::chrono::steady_clock::now();
+            drawTime = std::chrono::duration<double>(now - m_startTime).count() - m_updateStep;
+        }
+
+        auto interpolation = (drawTime - (stepTime - m_updateStep)) / m_updateStep;
+
+        return static_cast<float>(std::min(std::max(interpolation, 0.0), 1.0));
+    }
+
+    double Renderer::getStepTime() const {
+        return m_stepTime;
+    }
+
+    void Renderer::start() {
+        if (m_isStarted) {
+            return;
+        }
+
         onSizeChange(m_frameBufferWidth, m_frameBufferHeight);
 
-        // Render until ESCAPE key or X button is pressed.
-        do {
-            onDraw();
-            glfwSwapBuffers(m_window);
-            glfwPollEvents();
-        } while (glfwGetKey(m_window, GLFW_KEY_ESCAPE) != GLFW_PRESS
-                 && !glfwWindowShouldClose(m_window));
+        m_lastFrameTime = std::chrono::steady_clock::now();
+        m_nextFrameTime = m_lastFrameTime;
+        m_startTime = m_lastFrameTime;
+        m_isStarted = true;
+    }
 
-        // Close the window.
-        glfwTerminate();
+    void Renderer::renderFrame() {
+        m_profiler.beginFrame();
+
+        if (m_isUpdateThreaded) {
+            std::lock_guard<std::mutex> lock(m_updateErrorMutex);
+
+            if (m_updateError) {
+                auto error = m_updateError;
+
+                m_updateError = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+        else {
+            update();
+        }
+
+        GLState::beginFrame();
+        onDraw();
+        m_backend->present();
+        m_profiler.endFrame();
+
+        waitForNextFrame();
+    }
+
+    void Renderer::update() {
+        auto now = std::chrono::steady_clock::now();
+        auto frameTime = m_fixedFrameTime > 0.0
+                         ? m_fixedFrameTime
+                         : std::chrono::duration<double>(now - m_lastFrameTime).count();
+
+        m_lastFrameTime = now;
+        m_accumulatedTime += std::min(frameTime, MAX_FRAME_TIME);
+
+        Profiler::Scope scope(m_profiler, "Simulate");
+
+        while (m_accumulatedTime >= m_updateStep) {
+            m_stepTime += m_updateStep;
+            onUpdate(static_cast<float>(m_updateStep));
+            m_accumulatedTime -= m_updateStep;
+        }
+
+        m_interpolation = static_cast<float>(m_accumulatedTime / m_updateStep);
+        m_drawTime = m_stepTime - m_updateStep + m_accumulatedTime;
+    }
+
+    void Renderer::startUpdateThread() {
+        if (!m_isUpdateThreaded || m_updateThread.joinable()) {
+            return;
+        }
+
+        m_isUpdating = true;
+        m_updateThread = std::thread(&Renderer::runUpdateThread, this);
+    }
+
+    void Renderer::stopUpdateThread() {
+        if (!m_updateThread.joinable()) {
+            return;
+        }
+
+        m_isUpdating = false;
+        m_updateThread.join();
+    }
+
+    void Renderer::runUpdateThread() {
+        auto step = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(m_updateStep)
+        );
+
+        auto maxLag = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(MAX_FRAME_TIME)
+        );
+
+        // (Continues from the last step, if the thread ran before.)
+        auto nextTime = m_startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(m_stepTime + m_updateStep)
+        );
+
+        try {
+            while (m_isUpdating) {
+                std::this_thread::sleep_until(nextTime);
+
+                auto now = std::chrono::steady_clock::now();
+
+                // Too late: Skip the time, like update() does.
+                if (now - nextTime > maxLag) {
+                    m_stepTime = std::chrono::duration<double>(now - m_startTime).count() - m_updateStep;
+                    nextTime = now;
+                }
+
+                m_stepTime += m_updateStep;
+                onUpdate(static_cast<float>(m_updateStep));
+                nextTime += step;
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_updateErrorMutex);
+            m_updateError = std::current_exception();
+        }
+    }
+
+    void Renderer::waitForNextFrame() {
+        if (m_framePeriod <= 0.0) {
+            return;
+        }
+
+        m_nextFrameTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(m_framePeriod)
+        );
+
+        auto now = std::chrono::steady_clock::now();
+
+        // Too late: Start over from now, instead of rushing the next frames.
+        if (m_nextFrameTime < now) {
+            m_nextFrameTime = now;
+            return;
+        }
+
+        std::this_thread::sleep_until(m_nextFrameTime);
     }
 
     void Renderer::windowSizeCallback(GLFWwindow *context, int width, int height) {
@@ -5,17 +5,63 @@
 
 namespace Engine {
     // Class for using GLFW and GLEW easily. Just make a subclass, override onXXX(), and call run().
+    // With the offscreen backend, call renderFrames() instead. (width & height are the frame buffer size.)
+    //
+    // The simulation runs in fixed steps, apart from the frame rate: Each frame calls onUpdate() for every step
+    // of time which passed, then onDraw() once. Move things in onUpdate(), and draw them between their last
+    // two states with getInterpolation(), so they move the same at any frame rate.
+    //
+    // With setThreadedUpdate(true), onUpdate() runs on its own thread at the step rate instead, overlapping
+    // onDraw(). Then onUpdate() must not touch GL or anything onDraw() reads: Publish a snapshot of the
+    // state through a TripleBuffer, stamped with getStepTime(), and draw the newest one in onDraw().
     class Renderer {
     public:
-        Renderer(int width, int height, const std::string &title);
+        Renderer(int width, int height, const std::string &title, Backend::Type backendType = Backend::WINDOW);
+        virtual ~Renderer() = default;
 
-        // Start rendering.
+        // Start rendering. (Until ESCAPE key or X button is pressed. Needs a window.)
         void run();
 
+        // Render exactly count frames and return. (Can be called again to continue.)
+        void renderFrames(int count);
+
+        // Times of the last frames. (Add scopes around the passes in onDraw().)
+        Profiler &getProfiler();
+
+        // Number of the onUpdate() calls per second. (Default: 120)
+        void setUpdateRate(double rate);
+
+        // Wait for this many vertical blanks in each frame. (0: Uncapped, for benchmarks)
+        void setSwapInterval(int interval);
+
+        // Sleep to keep the frame rate under this. (0: No limit, default)
+        void setFrameLimit(double rate);
+
+        // Let every frame advance the time by this many seconds, whatever it took. (0: Real time, default)
+        // (For reproducible offscreen runs. Ignored if the update is threaded.)
+        void setFixedFrameTime(double seconds);
+
+        // Run onUpdate() on a simulation thread, while run() or renderFrames() runs. (Default: false)
+        void setThreadedUpdate(bool isThreaded);
+
     protected:
+        // Called in each fixed step. (dt: Length of the step in seconds.)
+        virtual void onUpdate(float dt) {};
+
         // Called in each frame.
         virtual void onDraw() {};
 
+        // How far the frame is from the last onUpdate() to the next one, in [0, 1].
+        // (Draw mix(previous state, current state, getInterpolation()). Not for the threaded update.)
+        float getInterpolation() const;
+
+        // Same for the states of the step which ended at stepTime. (Works with the threaded update, too.)
+        // The frames show the time 1 step behind, so the newest snapshot is mostly in [0, 1].
+        float getInterpolation(double stepTime) const;
+
+        // In onUpdate(): Time at the end of the step, in seconds from the start.
+        double getStepTime() const;
+
         // Called when the size of the window is changed.
         virtual void onSizeChange(int width, int height) {};
 
@@ -32,6 +78,23 @@ namespace Engine {
         virtual void onKeyRelease(int key) {};
 
     private:
+        // Call onSizeChange() once before the first frame.
+        void start();
+        void renderFrame();
+
+        // Call onUpdate() for the time which passed since the last frame.
+        void update();
+
+        // Start & stop the simulation thread. (If the update is threaded.)
+        void startUpdateThread();
+        void stopUpdateThread();
+
+        // Body of the simulation thread: Call onUpdate() on time, until stopUpdateThread().
+        void runUpdateThread();
+
+        // Sleep until the next frame is due.
+        void waitForNextFrame();
+
         static void windowSizeCallback(GLFWwindow *context, int width, int height);
         static void mouseButtonCallback(GLFWwindow *context, int button, int action, int mods);
         static void cursorPosCallback(GLFWwindow *context, double x, double y);
@@ -48,8 +111,37 @@ namespace Engine {
         // Window title.
         std::string m_title;
 
-        // GLFW window object.
+        // Context & default frame buffer.
+        std::unique_ptr<Backend> m_backend;
+
+        // GLFW window object. (nullptr if offscreen)
         GLFWwindow *m_window;
+
+        Profiler m_profiler;
+
+        // Simulation time. (Seconds)
+        double m_updateStep = 1.0 / 120.0;
+        double m_accumulatedTime = 0.0;
+        double m_fixedFrameTime = 0.0;
+        float m_interpolation = 0.0f;
+        // End of the last step, and the time the frame shows. (m_stepTime belongs to the updating thread.)
+        double m_stepTime = 0.0;
+        double m_drawTime = 0.0;
+        std::chrono::steady_clock::time_point m_startTime;
+
+        // Simulation thread. (An error in onUpdate() is thrown again by the next frame.)
+        bool m_isUpdateThreaded = false;
+        std::thread m_updateThread;
+        std::atomic<bool> m_isUpdating{false};
+        std::mutex m_updateErrorMutex;
+        std::exception_ptr m_updateError;
+
+        // Frame pacing.
+        double m_framePeriod = 0.0;
+        std::chrono::steady_clock::time_point m_lastFrameTime;
+        std::chrono::steady_clock::time_point m_nextFrameTime;
+
+        bool m_isStarted = false;
     };
 }
 
@@ -0,0 +1,692 @@
+#include "Engine.hpp"
+
+// Number of the bins of the SAH build.
+static const int BIN_COUNT = 12;
+// Proxy::node of the removed proxies.
+static const int REMOVED = -2;
+
+static float getArea(const glm::vec3 &min, const glm::vec3 &max);
+static float getDistanceSquared(const glm::vec3 &min, const glm::vec3 &max, const glm::vec3 &point);
+static bool intersectRay(
+        const glm::vec3 &min,
+        const glm::vec3 &max,
+        const glm::vec3 &origin,
+        const glm::vec3 &inverseDirection,
+        float maxDistance,
+        float &distance
+);
+
+namespace Engine {
+    int SceneTree::insert(const Bounds &bounds, Model *model, int instanceIndex, uint32_t groupMask) {
+        int proxyId;
+
+        if (m_freeProxyList.empty()) {
+            proxyId = static_cast<int>(m_proxyList.size());
+            m_proxyList.emplace_back();
+        }
+        else {
+            proxyId = m_freeProxyList.back();
+            m_freeProxyList.pop_back();
+        }
+
+        auto &proxy = m_proxyList[proxyId];
+
+        proxy.bounds = bounds;
+        proxy.model = model;
+        proxy.instanceIndex = instanceIndex;
+        proxy.groupMask = groupMask;
+        proxy.node = -1;
+        m_groupCountMap[groupMask]++;
+
+        if (bounds.isEmpty) {
+            m_unplacedList.push_back(proxyId);
+        }
+        else {
+            insertLeaf(proxyId);
+            rebuildIfNeeded();
+        }
+
+        return proxyId;
+    }
+
+    void SceneTree::remove(int proxyId) {
+        auto &proxy = m_proxyList[proxyId];
+
+        if (proxy.node == REMOVED) {
+            return;
+        }
+
+        if (proxy.node >= 0) {
+            removeLeaf(proxyId);
+            rebuildIfNeeded();
+        }
+        else {
+            m_unplacedList.erase(std::find(m_unplacedList.begin(), m_unplacedList.end(), proxyId));
+        }
+
+        if (--m_groupCountMap[proxy.groupMask] == 0) {
+            m_groupCountMap.erase(proxy.groupMask);
+        }
+
+        proxy.node = REMOVED;
+        proxy.model = nullptr;
+        m_freeProxyList.push_back(proxyId);
+    }
+
+    bool SceneTree::move(int proxyId, const Bounds &bounds) {
+        auto &proxy = m_proxyList[proxyId];
+        auto wasPlaced = proxy.node >= 0;
+
+        proxy.bounds = bounds;
+
+        if (bounds.isEmpty) {
+            if (!wasPlaced) {
+                return false;
+            }
+
+            removeLeaf(proxyId);
+            m_unplacedList.push_back(proxyId);
+            rebuildIfNeeded();
+
+            return true;
+        }
+
+        if (wasPlaced) {
+            auto &leaf = m_nodeList[proxy.node];
+
+            // Still inside the fat box, and the fat box is not too large for it. (Nothing to do.)
+            auto isInside = glm::all(glm::lessThanEqual(leaf.min, bounds.min))
+                            && glm::all(glm::lessThanEqual(bounds.max, leaf.max));
+            auto isTight = glm::all(glm::lessThanEqual(bounds.min - 4.0f * m_margin, leaf.min))
+                           && glm::all(glm::lessThanEqual(leaf.max, bounds.max + 4.0f * m_margin));
+
+            if (isInside && isTight) {
+                return false;
+            }
+
+            removeLeaf(proxyId);
+        }
+        else {
+            m_unplacedList.erase(std::find(m_unplacedList.begin(), m_unplacedList.end(), proxyId));
+        }
+
+        insertLeaf(proxyId);
+        rebuildIfNeeded();
+
+        return true;
+    }
+
+    void SceneTree::rebuild() {
+        std::vector<int> proxyIdList;
+
+        for (int proxyId = 0; proxyId < static_cast<int>(m_proxyList.size()); proxyId++) {
+            if (m_proxyList[proxyId].node >= 0) {
+                proxyIdList.push_back(proxyId);
+            }
+        }
+
+        m_nodeList.clear();
+        m_freeNodeList.clear();
+        m_innerArea = 0.0;
+        m_root = proxyIdList.empty() ? -1 : build(proxyIdList, 0, proxyIdList.size(), -1);
+        m_rebuildCost = getCost();
+    }
+
+    void SceneTree::queryFrustum(const Frustum &frustum, uint32_t groupMask, std::vector<int> &proxyList) const {
+        m_stackList.clear();
+
+        if (m_root >= 0) {
+            m_stackList.push_back(m_root);
+        }
+
+        while (!m_stackList.empty()) {
+            auto &node = m_nodeList[m_stackList.back()];
+            m_stackList.pop_back();
+
+            if ((node.groupMask & groupMask) == 0 || !frustum.testBox(node.min, node.max)) {
+                continue;
+            }
+
+            if (node.left >= 0) {
+                m_stackList.push_back(node.left);
+                m_stackList.push_back(node.right);
+                continue;
+            }
+
+            // The fat box touched it. Test the real one.
+            auto &bounds = m_proxyList[node.proxyId].bounds;
+
+            if (frustum.testBox(bounds.min, bounds.max)) {
+                proxyList.push_back(node.proxyId);
+            }
+        }
+
+        for (auto proxyId: m_unplacedList) {
+            if ((m_proxyList[proxyId].groupMask & groupMask) != 0) {
+                proxyList.push_back(proxyId);
+            }
+        }
+    }
+
+    void SceneTree::querySphere(
+            const glm::vec3 &center,
+            float radius,
+            uint32_t groupMask,
+            std::vector<int> &proxyList
+    ) const {
+        auto radiusSquared = radius * radius;
+
+        m_stackList.clear();
+
+        if (m_root >= 0) {
+            m_stackList.push_back(m_root);
+        }
+
+        while (!m_stackList.empty()) {
+            auto &node = m_nodeList[m_stackList.back()];
+            m_stackList.pop_back();
+
+            if ((node.groupMask & groupMask) == 0 || getDistanceSquared(node.min, node.max, center) > radiusSquared) {
+                continue;
+            }
+
+            if (node.left >= 0) {
+                m_stackList.push_back(node.left);
+                m_stackList.push_back(node.right);
+                continue;
+            }
+
+            auto &bounds = m_proxyList[node.proxyId].bounds;
+
+            if (getDistanceSquared(bounds.min, bounds.max, center) <= radiusSquared) {
+                proxyList.push_back(node.proxyId);
+            }
+        }
+
+        for (auto proxyId: m_unplacedList) {
+            if ((m_proxyList[proxyId].groupMask & groupMask) != 0) {
+                proxyList.push_back(proxyId);
+            }
+        }
+    }
+
+    void SceneTree::queryRay(
+            const glm::vec3 &origin,
+            const glm::vec3 &direction,
+            float maxDistance,
+            uint32_t groupMask,
+            std::vector<int> &proxyList
+    ) const {
+        // (Division by zero gives infinities, which the slab test handles.)
+        auto inverseDirection = 1.0f / direction;
+        std::vector<std::pair<float, int>> hitList;
+
+        m_stackList.clear();
+
+        if (m_root >= 0) {
+            m_stackList.push_back(m_root);
+        }
+
+        while (!m_stackList.empty()) {
+            auto &node = m_nodeList[m_stackList.back()];
+            float distance;
+
+            m_stackList.pop_back();
+
+            if ((node.groupMask & groupMask) == 0
+                || !intersectRay(node.min, node.max, origin, inverseDirection, maxDistance, distance)) {
+                continue;
+            }
+
+            if (node.left >= 0) {
+                m_stackList.push_back(node.left);
+                m_stackList.push_back(node.right);
+                continue;
+            }
+
+            auto &bounds = m_proxyList[node.proxyId].bounds;
+
+            if (intersectRay(bounds.min, bounds.max, origin, inverseDirection, maxDistance, distance)) {
+                hitList.emplace_back(distance, node.proxyId);
+            }
+        }
+
+        std::sort(hitList.begin(), hitList.end());
+
+        for (auto &hit: hitList) {
+            proxyList.push_back(hit.second);
+        }
+
+        for (auto proxyId: m_unplacedList) {
+            if ((m_proxyList[proxyId].groupMask & groupMask) != 0) {
+                proxyList.push_back(proxyId);
+            }
+        }
+    }
+
+    int SceneTree::findNearest(const glm::vec3 &point, uint32_t groupMask) const {
+        auto nearestProxyId = -1;
+        auto nearestDistance = std::numeric_limits<float>::infinity();
+
+        m_stackList.clear();
+
+        if (m_root >= 0) {
+            m_stackList.push_back(m_root);
+        }
+
+        // Branch and bound: Skip the nodes which can't be nearer than the best one so far.
+        while (!m_stackList.empty()) {
+            auto &node = m_nodeList[m_stackList.back()];
+            m_stackList.pop_back();
+
+            if ((node.groupMask & groupMask) == 0 || getDistanceSquared(node.min, node.max, point) >= nearestDistance) {
+                continue;
+            }
+
+            if (node.left >= 0) {
+                // Push the nearer child last, so it's visited first.
+                auto &left = m_nodeList[node.left];
+                auto &right = m_nodeList[node.right];
+                auto isLeftNearer = getDistanceSquared(left.min, left.max, point)
+                                    < getDistanceSquared(right.min, right.max, point);
+
+                m_stackList.push_back(isLeftNearer ? node.right : node.left);
+                m_stackList.push_back(isLeftNearer ? node.left : node.right);
+                continue;
+            }
+
+            auto &bounds = m_proxyList[node.proxyId].bounds;
+            auto distance = getDistanceSquared(bounds.min, bounds.max, point);
+
+            if (distance < nearestDistance) {
+                nearestDistance = distance;
+                nearestProxyId = node.proxyId;
+            }
+        }
+
+        // The unplaced ones have no position. Return one only if there's nothing else.
+        if (nearestProxyId < 0) {
+            for (auto proxyId: m_unplacedList) {
+                if ((m_proxyList[proxyId].groupMask & groupMask) != 0) {
+                    return proxyId;
+                }
+            }
+        }
+
+        return nearestProxyId;
+    }
+
+    Model *SceneTree::getModel(int proxyId) const {
+        return m_proxyList[proxyId].model;
+    }
+
+    int SceneTree::getInstanceIndex(int proxyId) const {
+        return m_proxyList[proxyId].instanceIndex;
+    }
+
+    const Bounds &SceneTree::getBounds(int proxyId) const {
+        return m_proxyList[proxyId].bounds;
+    }
+
+    int SceneTree::getCount(uint32_t groupMask) const {
+        int count = 0;
+
+        for (auto &groupCount: m_groupCountMap) {
+            if ((groupCount.first & groupMask) != 0) {
+                count += groupCount.second;
+            }
+        }
+
+        return count;
+    }
+
+    float SceneTree::getCost() const {
+        if (m_root < 0) {
+            return 0.0f;
+        }
+
+        auto rootArea = getArea(m_nodeList[m_root].min, m_nodeList[m_root].max);
+
+        return rootArea > 0.0f ? static_cast<float>(m_innerArea / rootArea) : 0.0f;
+    }
+
+    void SceneTree::setMargin(float margin) {
+        m_margin = margin;
+    }
+
+    void SceneTree::setRebuildRatio(float ratio) {
+        m_rebuildRatio = ratio;
+    }
+
+    int SceneTree::allocateNode() {
+        int node;
+
+        if (m_freeNodeList.empty()) {
+            node = static_cast<int>(m_nodeList.size());
+            m_nodeList.emplace_back();
+        }
+        else {
+            node = m_freeNodeList.back();
+            m_freeNodeList.pop_back();
+        }
+
+        // Zero area, so that the first setNodeBox() adds the whole area.
+        m_nodeList[node] = {glm::vec3(0.0f), glm::vec3(0.0f), 0u, -1, -1, -1, -1};
+
+        return node;
+    }
+
+    void SceneTree::freeNode(int node) {
+        setNodeBox(node, glm::vec3(0.0f), glm::vec3(0.0f));
+        m_freeNodeList.push_back(node);
+    }
+
+    void SceneTree::insertLeaf(int proxyId) {
+        auto &proxy = m_proxyList[proxyId];
+        auto leaf = allocateNode();
+
+        m_nodeList[leaf].min = proxy.bounds.min - glm::vec3(m_margin);
+        m_nodeList[leaf].max = proxy.bounds.max + glm::vec3(m_margin);
+        m_nodeList[leaf].groupMask = proxy.groupMask;
+        m_nodeList[leaf].proxyId = proxyId;
+        proxy.node = leaf;
+
+        if (m_root < 0) {
+            m_root = leaf;
+            return;
+        }
+
+        // Find the best sibling by walking down the cheaper side. (Box2D's heuristic)
+        auto leafMin = m_nodeList[leaf].min;
+        auto leafMax = m_nodeList[leaf].max;
+        auto sibling = m_root;
+
+        while (m_nodeList[sibling].left >= 0) {
+            auto &node = m_nodeList[sibling];
+            auto area = getArea(node.min, node.max);
+            auto combinedArea = getArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+            // Cost of making a new parent here, and the cost pushed down to the children if we go further.
+            auto cost = 2.0f * combinedArea;
+            auto inheritanceCost = 2.0f * (combinedArea - area);
+
+            float childCostList[2];
+            int childList[2] = {node.left, node.right};
+
+            for (int i = 0; i < 2; i++) {
+                auto &child = m_nodeList[childList[i]];
+                auto childArea = getArea(glm::min(child.min, leafMin), glm::max(child.max, leafMax));
+
+                childCostList[i] = child.left < 0
+                                   ? childArea + inheritanceCost
+                                   : childArea - getArea(child.min, child.max) + inheritanceCost;
+            }
+
+            if (cost < childCostList[0] && cost < childCostList[1]) {
+                break;
+            }
+
+            sibling = childCostList[0] < childCostList[1] ? childList[0] : childList[1];
+        }
+
+        // Make a new parent of the sibling and the leaf.
+        auto oldParent = m_nodeList[sibling].parent;
+        auto newParent = allocateNode();
+
+        m_nodeList[newParent].parent = oldParent;
+        m_nodeList[newParent].left = sibling;
+        m_nodeList[newParent].right = leaf;
+        m_nodeList[sibling].parent = newParent;
+        m_nodeList[leaf].parent = newParent;
+
+        if (oldParent < 0) {
+            m_root = newParent;
+        }
+        else if (m_nodeList[oldParent].left == sibling) {
+            m_nodeList[oldParent].left = newParent;
+        }
+        else {
+            m_nodeList[oldParent].right = newParent;
+        }
+
+        refit(newParent);
+    }
+
+    void SceneTree::removeLeaf(int proxyId) {
+        auto &proxy = m_proxyList[proxyId];
+        auto leaf = proxy.node;
+
+        proxy.node = -1;
+
+        if (leaf == m_root) {
+            m_root = -1;
+            freeNode(leaf);
+            return;
+        }
+
+        // Replace the parent with the sibling.
+        auto parent = m_nodeList[leaf].parent;
+        auto grandParent = m_nodeList[parent].parent;
+        auto sibling = m_nodeList[parent].left == leaf ? m_nodeList[parent].right : m_nodeList[parent].left;
+
+        m_nodeList[sibling].parent = grandParent;
+
+        if (grandParent < 0) {
+            m_root = sibling;
+        }
+        else if (m_nodeList[grandParent].left == parent) {
+            m_nodeList[grandParent].left = sibling;
+        }
+        else {
+            m_nodeList[grandParent].right = sibling;
+        }
+
+        freeNode(parent);
+        freeNode(leaf);
+
+        if (grandParent >= 0) {
+            refit(grandParent);
+        }
+    }
+
+    void SceneTree::refit(int node) {
+        while (node >= 0) {
+            auto &left = m_nodeList[m_nodeList[node].left];
+            auto &right = m_nodeList[m_nodeList[node].right];
+
+            setNodeBox(node, glm::min(left.min, right.min), glm::max(left.max, right.max));
+            m_nodeList[node].groupMask = left.groupMask | right.groupMask;
+
+            node = m_nodeList[node].parent;
+        }
+    }
+
+    void SceneTree::setNodeBox(int node, const glm::vec3 &min, const glm::vec3 &max) {
+        auto &target = m_nodeList[node];
+
+        // (Leaves are not counted.)
+        if (target.left >= 0) {
+            m_innerArea += getArea(min, max) - getArea(target.min, target.max);
+        }
+
+        target.min = min;
+        target.max = max;
+    }
+
+    int SceneTree::build(std::vector<int> &proxyIdList, size_t begin, size_t end, int parent) {
+        auto node = allocateNode();
+
+        m_nodeList[node].parent = parent;
+
+        if (end - begin == 1) {
+            auto proxyId = proxyIdList[begin];
+            auto &proxy = m_proxyList[proxyId];
+
+            m_nodeList[node].min = proxy.bounds.min - glm::vec3(m_margin);
+            m_nodeList[node].max = proxy.bounds.max + glm::vec3(m_margin);
+            m_nodeList[node].groupMask = proxy.groupMask;
+            m_nodeList[node].proxyId = proxyId;
+            proxy.node = node;
+
+            return node;
+        }
+
+        // Split along the longest axis of the centers.
+        auto centerMin = glm::vec3(std::numeric_limits<float>::max());
+        auto centerMax = glm::vec3(-std::numeric_limits<float>::max());
+
+        for (auto i = begin; i < end; i++) {
+            auto &bounds = m_proxyList[proxyIdList[i]].bounds;
+
+            centerMin = glm::min(centerMin, bounds.center);
+            centerMax = glm::max(centerMax, bounds.center);
+        }
+
+        auto extent = centerMax - centerMin;
+        auto axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+        auto middle = begin + (end - begin) / 2;
+
+        if (extent[axis] > 0.0f) {
+            // Put the centers into the bins and find the split with the lowest SAH cost.
+            auto scale = BIN_COUNT / extent[axis];
+            auto getBin = [&](int proxyId) {
+                auto bin = static_cast<int>((m_proxyList[proxyId].bounds.center[axis] - centerMin[axis]) * scale);
+
+                return std::min(bin, BIN_COUNT - 1);
+            };
+
+            int countList[BIN_COUNT] = {0};
+            glm::vec3 minList[BIN_COUNT];
+            glm::vec3 maxList[BIN_COUNT];
+
+            std::fill(std::begin(minList), std::end(minList), glm::vec3(std::numeric_limits<float>::max()));
+            std::fill(std::begin(maxList), std::end(maxList), glm::vec3(-std::numeric_limits<float>::max()));
+
+            for (auto i = begin; i < end; i++) {
+                auto &bounds = m_proxyList[proxyIdList[i]].bounds;
+                auto bin = getBin(proxyIdList[i]);
+
+                countList[bin]++;
+                minList[bin] = glm::min(minList[bin], bounds.min);
+                maxList[bin] = glm::max(maxList[bin], bounds.max);
+            }
+
+            // Sweep from the right to get the cost of the right sides, then from the left.
+            float rightCostList[BIN_COUNT];
+            auto sweepMin = glm::vec3(std::numeric_limits<float>::max());
+            auto sweepMax = glm::vec3(-std::numeric_limits<float>::max());
+            int sweepCount = 0;
+
+            for (int bin = BIN_COUNT - 1; bin > 0; bin--) {
+                sweepMin = glm::min(sweepMin, minList[bin]);
+                sweepMax = glm::max(sweepMax, maxList[bin]);
+                sweepCount += countList[bin];
+                rightCostList[bin] = sweepCount > 0 ? getArea(sweepMin, sweepMax) * sweepCount : 0.0f;
+            }
+
+            auto bestCost = std::numeric_limits<float>::infinity();
+            auto bestBin = -1;
+
+            sweepMin = glm::vec3(std::numeric_limits<float>::max());
+            sweepMax = glm::vec3(-std::numeric_limits<float>::max());
+            sweepCount = 0;
+
+            for (int bin = 1; bin < BIN_COUNT; bin++) {
+                sweepMin = glm::min(sweepMin, minList[bin - 1]);
+                sweepMax = glm::max(sweepMax, maxList[bin - 1]);
+                sweepCount += countList[bin - 1];
+
+                if (sweepCount == 0 || sweepCount == static_cast<int>(end - begin)) {
+                    continue;
+                }
+
+                auto cost = getArea(sweepMin, sweepMax) * sweepCount + rightCostList[bin];
+
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestBin = bin;
+                }
+            }
+
+            if (bestBin > 0) {
+                auto split = std::partition(
+                        proxyIdList.begin() + begin,
+                        proxyIdList.begin() + end,
+                        [&](int proxyId) {
+                            return getBin(proxyId) < bestBin;
+                        }
+                );
+
+                middle = static_cast<size_t>(split - proxyIdList.begin());
+            }
+        }
+
+        // All the centers at one point (or in one bin): Split in half.
+        if (middle == begin || middle == end) {
+            middle = begin + (end - begin) / 2;
+        }
+
+        auto left = build(proxyIdList, begin, middle, node);
+        auto right = build(proxyIdList, middle, end, node);
+
+        m_nodeList[node].left = left;
+        m_nodeList[node].right = right;
+
+        m_nodeList[node].groupMask = m_nodeList[left].groupMask | m_nodeList[right].groupMask;
+        setNodeBox(
+                node,
+                glm::min(m_nodeList[left].min, m_nodeList[right].min),
+                glm::max(m_nodeList[left].max, m_nodeList[right].max)
+        );
+
+        return node;
+    }
+
+    void SceneTree::rebuildIfNeeded() {
+        auto cost = getCost();
+
+        // The first tree with some inner nodes sets the baseline.
+        if (m_rebuildCost <= 0.0f) {
+            m_rebuildCost = cost;
+            return;
+        }
+
+        if (cost > m_rebuildCost * m_rebuildRatio) {
+            rebuild();
+        }
+    }
+}
+
+static float getArea(const glm::vec3 &min, const glm::vec3 &max) {
+    auto size = max - min;
+
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+static float getDistanceSquared(const glm::vec3 &min, const glm::vec3 &max, const glm::vec3 &point) {
+    auto offset = glm::max(glm::vec3(0.0f), glm::max(min - point, point - max));
+
+    return glm::dot(offset, offset);
+}
+
+static bool intersectRay(
+        const glm::vec3 &min,
+        const glm::vec3 &max,
+        const glm::vec3 &origin,
+        const glm::vec3 &inverseDirection,
+        float maxDistance,
+        float &distance
+) {
+    // Slab test. (Starts at 0, so a ray from inside of the box hits it at the distance 0.)
+    auto t0 = (min - origin) * inverseDirection;
+    auto t1 = (max - origin) * inverseDirection;
+    auto tNear = glm::min(t0, t1);
+    auto tFar = glm::max(t0, t1);
+
+    auto enter = std::max(0.0f, std::max(tNear.x, std::max(tNear.y, tNear.z)));
+    auto exit = std::min(maxDistance, std::min(tFar.x, std::min(tFar.y, tFar.z)));
+
+    distance = enter;
+
+    return enter <= exit;
+}
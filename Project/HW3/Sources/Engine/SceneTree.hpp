@@ -0,0 +1,122 @@
+#ifndef ENGINE_SCENE_TREE_HPP
+#define ENGINE_SCENE_TREE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Dynamic bounding volume hierarchy over the placed objects of a scene.
+    // Each proxy is a box with a model, an instance index (-1: The whole model) and group bits.
+    // The leaves store 'fat' boxes, so small moves don't touch the tree. When the tree gets much worse than
+    // the last rebuild (by the surface area heuristic), it's rebuilt from scratch on the next update.
+    //
+    // Proxies with empty bounds can't be placed. They are kept aside and returned by every query.
+    class SceneTree {
+    public:
+        // Insert an object and return its proxy id.
+        int insert(const Bounds &bounds, Model *model, int instanceIndex = -1, uint32_t groupMask = ~0u);
+
+        void remove(int proxyId);
+
+        // Update the bounds of the proxy. Returns true if the tree changed.
+        bool move(int proxyId, const Bounds &bounds);
+
+        // Build the tree again from the current proxies. (Top-down, binned SAH.)
+        void rebuild();
+
+        // Queries. The proxies which have any of the bits in groupMask are appended to proxyList.
+        // -- Touching the frustum.
+        void queryFrustum(const Frustum &frustum, uint32_t groupMask, std::vector<int> &proxyList) const;
+        // -- Touching the sphere.
+        void querySphere(const glm::vec3 &center, float radius, uint32_t groupMask, std::vector<int> &proxyList) const;
+        // -- Hit by the ray, nearest first. (By the distance to the box.)
+        void queryRay(
+                const glm::vec3 &origin,
+                const glm::vec3 &direction,
+                float maxDistance,
+                uint32_t groupMask,
+                std::vector<int> &proxyList
+        ) const;
+
+        // The proxy whose box is the nearest to the point. (-1 if there's none.)
+        int findNearest(const glm::vec3 &point, uint32_t groupMask) const;
+
+        // Getters.
+        Model *getModel(int proxyId) const;
+        int getInstanceIndex(int proxyId) const;
+        // Bounds given to insert() or move(). (Not the fat ones.)
+        const Bounds &getBounds(int proxyId) const;
+        // Number of the proxies which have any of the bits.
+        int getCount(uint32_t groupMask) const;
+        // Surface area heuristic cost of the tree, relative to the root. (Lower is better.)
+        float getCost() const;
+
+        // Fat margin added to the boxes of the leaves.
+        void setMargin(float margin);
+        // Rebuild when the cost grows by this ratio from the last rebuild.
+        void setRebuildRatio(float ratio);
+
+    private:
+        struct Node {
+            glm::vec3 min;
+            glm::vec3 max;
+            // Union of the group bits below.
+            uint32_t groupMask;
+            int parent;
+            // -1 for the leaves.
+            int left;
+            int right;
+            // -1 for the inner nodes.
+            int proxyId;
+        };
+
+        struct Proxy {
+            Bounds bounds;
+            Model *model;
+            int instanceIndex;
+            uint32_t groupMask;
+            // Leaf of the proxy. (-1: Unplaced, -2: Removed)
+            int node;
+        };
+
+        int allocateNode();
+        void freeNode(int node);
+
+        // Put the leaf of the proxy into the tree / take it out.
+        void insertLeaf(int proxyId);
+        void removeLeaf(int proxyId);
+
+        // Recompute the boxes & the masks from the node to the root.
+        void refit(int node);
+
+        // Set the box of the node. (Keeps m_innerArea up to date.)
+        void setNodeBox(int node, const glm::vec3 &min, const glm::vec3 &max);
+
+        // Build the subtree over the proxies in [begin, end) and return its root.
+        int build(std::vector<int> &proxyIdList, size_t begin, size_t end, int parent);
+
+        void rebuildIfNeeded();
+
+        std::vector<Node> m_nodeList;
+        std::vector<Proxy> m_proxyList;
+        // Reusable indices of m_nodeList / m_proxyList.
+        std::vector<int> m_freeNodeList;
+        std::vector<int> m_freeProxyList;
+        // Proxies with empty bounds.
+        std::vector<int> m_unplacedList;
+        // Number of the proxies per group mask. (Scenes use only a few masks, so getCount() is cheap.)
+        std::map<uint32_t, int> m_groupCountMap;
+
+        // Scratch stack of the queries.
+        mutable std::vector<int> m_stackList;
+
+        int m_root = -1;
+        // Sum of the surface areas of the inner nodes. (Kept up to date, so getCost() is O(1).)
+        double m_innerArea = 0.0;
+
+        float m_margin = 0.1f;
+        float m_rebuildRatio = 2.0f;
+        float m_rebuildCost = 0.0f;
+    };
+}
+
+#endif
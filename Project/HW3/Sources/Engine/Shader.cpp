@@ -3,52 +3,100 @@
 static std::string readFile(const std::string &path);
 
 namespace Engine {
-    Shader::Shader(Shader::Type type, const std::string &path) {
-        // Read the shader.
-        auto code = readFile(path);
-        auto codePtr = code.c_str();
+    Shader::Shader(Shader::Type type, const std::string &path, const std::vector<std::string> &defineList) :
+            m_type(type),
+            m_path(path),
+            m_defineList(defineList),
+            m_source(readFile(path)) {
+        if (defineList.empty()) {
+            return;
+        }
+
+        std::string defines;
+
+        for (auto &define: defineList) {
+            defines += "#define " + define + "\n";
+        }
+
+        // The #version line must stay first.
+        auto versionStart = m_source.find("#version");
+        size_t insertPosition = 0;
+
+        if (versionStart != std::string::npos) {
+            auto versionEnd = m_source.find('\n', versionStart);
+
+            insertPosition = versionEnd != std::string::npos ? versionEnd + 1 : m_source.size();
+
+            if (versionEnd == std::string::npos) {
+                defines = "\n" + defines;
+            }
+        }
+
+        m_source.insert(insertPosition, defines);
+    }
+
+    void Shader::compile() {
+        if (m_id != 0) {
+            return;
+        }
+
+        auto codePtr = m_source.c_str();
 
-        // Compile the shader.
-        m_id = glCreateShader(type);
+        m_id = glCreateShader(m_type);
 
         glShaderSource(m_id, 1, &codePtr, nullptr);
         glCompileShader(m_id);
+    }
+
+    void Shader::check() {
+        compile();
+
+        if (m_isChecked) {
+            return;
+        }
 
-        // Check the shader.
         GLint result;
         GLint logLength;
 
         glGetShaderiv(m_id, GL_COMPILE_STATUS, &result);
-        glGetShaderiv(m_id, GL_INFO_LOG_LENGTH, &logLength);
 
-        if (logLength > 1) {
-            auto log = std::vector<char>(static_cast<unsigned>(logLength) + 1);
+        if (result != GL_TRUE) {
+            glGetShaderiv(m_id, GL_INFO_LOG_LENGTH, &logLength);
+
+            auto log = std::vector<char>(static_cast<unsigned>(std::max(logLength, 0)) + 1);
 
             glGetShaderInfoLog(m_id, logLength, nullptr, log.data());
 
-            throw std::runtime_error(log.data());
+            throw std::runtime_error("Error: Failed to compile \"" + m_path + "\".\n" + log.data());
         }
+
+        m_isChecked = true;
     }
 
-    GLuint Shader::getId() const {
-        return m_id;
+    Shader::Type Shader::getType() const {
+        return m_type;
     }
-}
 
-static std::string readFile(const std::string &path) {
-    std::string data;
-    std::ifstream stream(path, std::ios::in);
+    const std::string &Shader::getPath() const {
+        return m_path;
+    }
 
-    if (!stream.is_open()) {
-        throw std::runtime_error("Error: File \"" + path + "\" does not exist.");
+    const std::vector<std::string> &Shader::getDefineList() const {
+        return m_defineList;
     }
 
-    std::string line;
+    const std::string &Shader::getSource() const {
+        return m_source;
+    }
 
-    while (std::getline(stream, line)) {
-        data += "\n" + line;
+    GLuint Shader::getId() const {
+        return m_id;
     }
+}
+
+static std::string readFile(const std::string &path) {
+    // (Throws if the file doesn't exist.)
+    Engine::MappedFile file(path);
 
-    stream.close();
-    return data;
+    return std::string(reinterpret_cast<const char *>(file.getData()), file.getSize());
 }
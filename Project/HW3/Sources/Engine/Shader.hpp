@@ -4,7 +4,8 @@
 #include "Engine.hpp"
 
 namespace Engine {
-    // Shader object.
+    // Shader object. The source is read at construction, but only compiled when a program needs it.
+    // (A program loaded from the ProgramCache never compiles its shaders.)
     class Shader {
     public:
         enum Type {
@@ -12,12 +13,34 @@ namespace Engine {
             FRAGMENT = GL_FRAGMENT_SHADER
         };
 
-        Shader(Type type, const std::string &path);
+        // defineList: "NAME" or "NAME VALUE" each, added as #defines after the #version line.
+        Shader(Type type, const std::string &path, const std::vector<std::string> &defineList = {});
 
+        // Start compiling. This returns at once, so the driver can compile several shaders in the background.
+        // (Does nothing if already compiled.)
+        void compile();
+
+        // Wait for the compile to finish. Throws with the info log if it failed.
+        void check();
+
+        Type getType() const;
+        const std::string &getPath() const;
+        const std::vector<std::string> &getDefineList() const;
+
+        // The source with the #defines.
+        const std::string &getSource() const;
+
+        // (0 until compile().)
         GLuint getId() const;
 
     private:
-        GLuint m_id;
+        Type m_type;
+        std::string m_path;
+        std::vector<std::string> m_defineList;
+        std::string m_source;
+
+        GLuint m_id = 0;
+        bool m_isChecked = false;
     };
 }
 
@@ -12,14 +12,6 @@ namespace Engine {
             m_shadowMap = shadowMap;
         }
 
-        void setLightViewMatrix(const glm::mat4 &matrix) {
-            m_lightViewMatrix = matrix;
-        }
-
-        void setLightProjectionMatrix(const glm::mat4 &matrix) {
-            m_lightProjectionMatrix = matrix;
-        }
-
     protected:
         virtual void onDraw() {
             T::onDraw();
@@ -28,15 +20,13 @@ namespace Engine {
                 throw std::runtime_error("Error: Shadow map is not set.");
             }
 
-            this->m_program->setUniform("shadowMapUnit", m_shadowMap->getUnit());
-            this->m_program->setUniform("lightViewMatrix", m_lightViewMatrix);
-            this->m_program->setUniform("lightProjectionMatrix", m_lightProjectionMatrix);
+            static const UniformHandle<GLint> shadowMapUnit{"shadowMapUnit"};
+
+            this->m_program->setUniform(shadowMapUnit, m_shadowMap->getUnit());
         }
 
+        // (The light matrices are shared through the ViewBuffer.)
         Texture *m_shadowMap = nullptr;
-
-        glm::mat4 m_lightViewMatrix;
-        glm::mat4 m_lightProjectionMatrix;
     };
 }
 
@@ -1,23 +1,38 @@
 #include "Engine.hpp"
 
+// Anisotropic filtering of the mipmapped textures, where supported.
+static const GLfloat MAX_ANISOTROPY = 8.0f;
+
 static GLint generateUnit();
+static bool hasExtension(const char *name);
 
 namespace Engine {
-    Texture::Texture(const std::string &path) {
-        GLsizei width;
-        GLsizei height;
-        unsigned char *data = SOIL_load_image(path.c_str(), &width, &height, nullptr, SOIL_LOAD_RGB);
+    Texture::Texture(const std::string &path, TextureCache::Format format) {
+        auto cache = TextureCache::open(path, getSupportedFormat(format));
+        std::vector<const GLvoid *> levelDataList;
 
-        if (data == nullptr) {
-            std::stringstream messageStream;
+        for (int i = 0; i < cache->getLevelCount(); i++) {
+            levelDataList.push_back(cache->getLevel(i).data);
+        }
 
-            messageStream << "Error: " << SOIL_last_result() << ".";
+        m_unit = generateUnit();
 
-            throw std::runtime_error(messageStream.str());
-        }
+        glGenTextures(1, &m_id);
+        setLevels(*cache, levelDataList);
+    }
+
+    Texture::Texture(TextureLoader &loader, const std::string &path, TextureCache::Format format) {
+        static const unsigned char FALLBACK_COLOR[3] = {128, 128, 128};
 
-        create(width, height, {data}, GL_RGB, GL_RGB, false);
-        SOIL_free_image_data(data);
+        m_unit = generateUnit();
+        m_isReady = false;
+
+        glGenTextures(1, &m_id);
+        GLState::bindTexture(m_unit, GL_TEXTURE_2D, m_id);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, 1, 1, 0, GL_RGB, GL_UNSIGNED_BYTE, FALLBACK_COLOR);
+        setParameters(GL_TEXTURE_2D, false);
+
+        loader.load(*this, path, getSupportedFormat(format));
     }
 
     Texture::Texture(
@@ -49,6 +64,10 @@ namespace Engine {
         return m_unit;
     }
 
+    bool Texture::isReady() const {
+        return m_isReady;
+    }
+
     void Texture::create(
             GLsizei width,
             GLsizei height,
@@ -60,8 +79,7 @@ namespace Engine {
         m_unit = generateUnit();
 
         glGenTextures(1, &m_id);
-        glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + m_unit));
-        glBindTexture(isCubeMap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, m_id);
+        GLState::bindTexture(m_unit, isCubeMap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, m_id);
 
         if (isCubeMap) {
             for (int face = 0; face < 6; face++) {
@@ -92,10 +110,89 @@ namespace Engine {
             );
         }
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        setParameters(isCubeMap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, false);
+    }
+
+    void Texture::setLevels(const TextureCache &cache, const std::vector<const GLvoid *> &levelDataList) {
+        GLState::selectTexture(m_unit, GL_TEXTURE_2D, m_id);
+
+        auto format = cache.getFormat();
+        auto internalFormat = TextureCache::getInternalFormat(format);
+
+        // The small uncompressed levels have rows of any length.
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        for (int i = 0; i < cache.getLevelCount(); i++) {
+            auto level = cache.getLevel(i);
+
+            if (TextureCache::isCompressed(format)) {
+                glCompressedTexImage2D(
+                        GL_TEXTURE_2D,
+                        i,
+                        internalFormat,
+                        level.width,
+                        level.height,
+                        0,
+                        level.size,
+                        levelDataList[i]
+                );
+            }
+            else {
+                glTexImage2D(
+                        GL_TEXTURE_2D,
+                        i,
+                        internalFormat,
+                        level.width,
+                        level.height,
+                        0,
+                        format == TextureCache::Format::RGBA ? GL_RGBA : GL_RGB,
+                        GL_UNSIGNED_BYTE,
+                        levelDataList[i]
+                );
+            }
+        }
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, cache.getLevelCount() - 1);
+
+        setParameters(GL_TEXTURE_2D, true);
+        m_isReady = true;
+    }
+
+    TextureCache::Format Texture::getSupportedFormat(TextureCache::Format format) {
+        // Without S3TC, keep the chain uncompressed. (RGTC is core since GL 3.0.)
+        static const bool isS3TCSupported = hasExtension("GL_EXT_texture_compression_s3tc");
+
+        if (!isS3TCSupported && format == TextureCache::Format::BC1) {
+            return TextureCache::Format::RGB;
+        }
+
+        if (!isS3TCSupported && format == TextureCache::Format::BC3) {
+            return TextureCache::Format::RGBA;
+        }
+
+        return format;
+    }
+
+    void Texture::setParameters(GLenum target, bool isMipmapped) {
+        static const bool isAnisotropySupported = hasExtension("GL_EXT_texture_filter_anisotropic");
+
+        // (The render targets & data textures stay unfiltered.)
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, isMipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, isMipmapped ? GL_LINEAR : GL_NEAREST);
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        if (target == GL_TEXTURE_CUBE_MAP) {
+            glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        }
+
+        if (isMipmapped && isAnisotropySupported) {
+            GLfloat maxAnisotropy;
+
+            glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &maxAnisotropy);
+            glTexParameterf(target, GL_TEXTURE_MAX_ANISOTROPY_EXT, std::min(maxAnisotropy, MAX_ANISOTROPY));
+        }
     }
 }
 
@@ -106,3 +203,20 @@ static GLint generateUnit() {
 
     return currUnit;
 }
+
+static bool hasExtension(const char *name) {
+    // (glGetString(GL_EXTENSIONS) is gone from the core profile, and GLEW 1.9 still relies on it.)
+    GLint count = 0;
+
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    for (GLint i = 0; i < count; i++) {
+        auto extension = reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+
+        if (extension != nullptr && std::strcmp(extension, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -4,11 +4,17 @@
 #include "Engine.hpp"
 
 namespace Engine {
+    class TextureLoader;
+
     // Texture object.
     class Texture {
     public:
-        // Constructor: Use the image file.
-        explicit Texture(const std::string &path);
+        // Constructor: Use the image file. (Uploads its mip chain from the TextureCache, importing it if needed.)
+        explicit Texture(const std::string &path, TextureCache::Format format = TextureCache::Format::BC1);
+
+        // Constructor: Use the image file, loaded in the background by the loader.
+        // (A 1x1 gray fallback until then. See isReady().)
+        Texture(TextureLoader &loader, const std::string &path, TextureCache::Format format = TextureCache::Format::BC1);
 
         // Constructor: Provide the data directly.
         Texture(
@@ -23,7 +29,12 @@ namespace Engine {
         GLuint getId() const;
         GLint getUnit() const;
 
+        // False while the image is still being loaded in the background.
+        bool isReady() const;
+
     private:
+        friend class TextureLoader;
+
         void create(
                 GLsizei width,
                 GLsizei height,
@@ -33,8 +44,19 @@ namespace Engine {
                 bool isCubeMap
         );
 
+        // Define the mip chain of the cache, and mark the texture as ready.
+        // (One data pointer per level. They're offsets while an unpack buffer is bound.)
+        void setLevels(const TextureCache &cache, const std::vector<const GLvoid *> &levelDataList);
+
+        // The format itself, or its uncompressed fallback if the driver can't sample it.
+        static TextureCache::Format getSupportedFormat(TextureCache::Format format);
+
+        // Filtering and wrapping of the bound texture.
+        static void setParameters(GLenum target, bool isMipmapped);
+
         GLint m_unit;
         GLuint m_id;
+        bool m_isReady = true;
     };
 }
 
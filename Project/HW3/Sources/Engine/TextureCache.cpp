@@ -0,0 +1,387 @@
+#include "Engine.hpp"
+
+// SOIL's block encoders. (Defined in image_DXT.c, but not declared in its header.)
+extern "C" {
+void compress_DDS_color_block(int channels, const unsigned char *uncompressed, unsigned char compressed[8]);
+void compress_DDS_alpha_block(const unsigned char *uncompressed, unsigned char compressed[8]);
+}
+
+static const char MAGIC[4] = {'C', 'G', 'L', 'T'};
+
+// More levels than this can't come from a valid image.
+static const uint32_t MAX_LEVEL_COUNT = 32;
+
+static int getChannelCount(Engine::TextureCache::Format format);
+
+static std::vector<unsigned char> downsample(
+        const std::vector<unsigned char> &image,
+        int width,
+        int height,
+        int channels
+);
+
+static std::vector<unsigned char> encode(
+        const std::vector<unsigned char> &image,
+        int width,
+        int height,
+        int channels,
+        Engine::TextureCache::Format format
+);
+
+static void encodeAlphaBlock(const unsigned char *block, int channel, unsigned char *output);
+
+namespace Engine {
+    std::unique_ptr<TextureCache> TextureCache::load(const std::string &sourcePath, Format format) {
+        uint64_t sourceSize;
+        int64_t sourceTime;
+
+        if (!MappedFile::readStatus(sourcePath, sourceSize, sourceTime)) {
+            return nullptr;
+        }
+
+        auto cachePath = getCachePath(sourcePath, format);
+        std::unique_ptr<MappedFile> file;
+
+        try {
+            file.reset(new MappedFile(cachePath));
+        }
+        catch (const std::runtime_error &) {
+            return nullptr;
+        }
+
+        if (file->getSize() < sizeof(Header)) {
+            return nullptr;
+        }
+
+        auto header = reinterpret_cast<const Header *>(file->getData());
+
+        if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+            || header->version != VERSION
+            || header->sourceSize != sourceSize
+            || header->format != static_cast<uint32_t>(format)
+            || header->levelCount == 0
+            || header->levelCount > MAX_LEVEL_COUNT
+            || file->getSize() < sizeof(Header) + header->levelCount * sizeof(LevelHeader)) {
+            return nullptr;
+        }
+
+        auto levelHeaderList = reinterpret_cast<const LevelHeader *>(file->getData() + sizeof(Header));
+
+        for (uint32_t i = 0; i < header->levelCount; i++) {
+            if (levelHeaderList[i].offset > file->getSize()
+                || levelHeaderList[i].size > file->getSize() - levelHeaderList[i].offset) {
+                return nullptr;
+            }
+        }
+
+        // The source was touched. Only rebuild if its contents really changed.
+        if (header->sourceTime != sourceTime) {
+            if (header->sourceHash != MappedFile::hashFile(sourcePath)) {
+                return nullptr;
+            }
+
+            // Same contents: Store the new time, so that the next loads skip the hash again. (Like MeshCache.)
+            file.reset();
+
+            if (MappedFile::overwrite(cachePath, offsetof(Header, sourceTime), &sourceTime, sizeof(sourceTime))) {
+                return load(sourcePath, format);
+            }
+
+            try {
+                file.reset(new MappedFile(cachePath));
+            }
+            catch (const std::runtime_error &) {
+                return nullptr;
+            }
+        }
+
+        return std::unique_ptr<TextureCache>(new TextureCache(std::move(file)));
+    }
+
+    std::unique_ptr<TextureCache> TextureCache::import(const std::string &sourcePath, Format format) {
+        // SOIL's PNG decoder keeps its Huffman tables in statics, so only one image is decoded at a time.
+        // (The filtering and compression below still run in parallel.)
+        static std::mutex decodeMutex;
+
+        auto channels = getChannelCount(format);
+        int width;
+        int height;
+        std::vector<unsigned char> image;
+
+        {
+            std::lock_guard<std::mutex> lock(decodeMutex);
+
+            unsigned char *data = SOIL_load_image(
+                    sourcePath.c_str(),
+                    &width,
+                    &height,
+                    nullptr,
+                    channels == 4 ? SOIL_LOAD_RGBA : SOIL_LOAD_RGB
+            );
+
+            if (data == nullptr) {
+                std::stringstream messageStream;
+
+                messageStream << "Error: " << SOIL_last_result() << ".";
+
+                throw std::runtime_error(messageStream.str());
+            }
+
+            image.assign(data, data + static_cast<size_t>(width) * height * channels);
+            SOIL_free_image_data(data);
+        }
+
+        // Build the chain with GL's sizes: Each level is half the last one, rounded down, until 1x1.
+        std::vector<LevelHeader> levelHeaderList;
+        std::vector<std::vector<unsigned char>> levelDataList;
+        auto levelWidth = width;
+        auto levelHeight = height;
+        auto offset = static_cast<uint64_t>(sizeof(Header));
+
+        while (true) {
+            levelDataList.push_back(encode(image, levelWidth, levelHeight, channels, format));
+            levelHeaderList.push_back({
+                    static_cast<uint32_t>(levelWidth),
+                    static_cast<uint32_t>(levelHeight),
+                    0,
+                    levelDataList.back().size()
+            });
+
+            if (levelWidth == 1 && levelHeight == 1) {
+                break;
+            }
+
+            image = downsample(image, levelWidth, levelHeight, channels);
+            levelWidth = std::max(levelWidth / 2, 1);
+            levelHeight = std::max(levelHeight / 2, 1);
+        }
+
+        offset += levelHeaderList.size() * sizeof(LevelHeader);
+
+        for (auto &levelHeader: levelHeaderList) {
+            levelHeader.offset = offset;
+            offset += levelHeader.size;
+        }
+
+        Header header{};
+
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.format = static_cast<uint32_t>(format);
+        header.width = static_cast<uint32_t>(width);
+        header.height = static_cast<uint32_t>(height);
+        header.levelCount = static_cast<uint32_t>(levelHeaderList.size());
+
+        auto isKeyed = MappedFile::readStatus(sourcePath, header.sourceSize, header.sourceTime);
+
+        if (isKeyed) {
+            header.sourceHash = MappedFile::hashFile(sourcePath);
+        }
+
+        // The file image is built in memory, so this import is used as is, without reading it back.
+        std::vector<unsigned char> buffer(static_cast<size_t>(offset));
+        auto output = buffer.data();
+
+        std::memcpy(output, &header, sizeof(Header));
+        std::memcpy(output + sizeof(Header), levelHeaderList.data(), levelHeaderList.size() * sizeof(LevelHeader));
+
+        for (size_t i = 0; i < levelDataList.size(); i++) {
+            std::memcpy(output + levelHeaderList[i].offset, levelDataList[i].data(), levelDataList[i].size());
+        }
+
+        if (isKeyed) {
+            MappedFile::writeAtomically(getCachePath(sourcePath, format), buffer.data(), buffer.size());
+        }
+
+        return std::unique_ptr<TextureCache>(new TextureCache(std::move(buffer)));
+    }
+
+    std::unique_ptr<TextureCache> TextureCache::open(const std::string &sourcePath, Format format) {
+        auto cache = load(sourcePath, format);
+
+        if (cache == nullptr) {
+            cache = import(sourcePath, format);
+        }
+
+        return cache;
+    }
+
+    std::string TextureCache::getCachePath(const std::string &sourcePath, Format format) {
+        static const char *const FORMAT_NAMES[] = {"bc1", "bc3", "bc5", "rgb", "rgba"};
+
+        return sourcePath + "." + FORMAT_NAMES[static_cast<int>(format)] + ".tex";
+    }
+
+    bool TextureCache::isCompressed(Format format) {
+        return format == Format::BC1 || format == Format::BC3 || format == Format::BC5;
+    }
+
+    GLenum TextureCache::getInternalFormat(Format format) {
+        switch (format) {
+            case Format::BC1:
+                return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+            case Format::BC3:
+                return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+            case Format::BC5:
+                return GL_COMPRESSED_RG_RGTC2;
+            case Format::RGB:
+                return GL_RGB8;
+            default:
+                return GL_RGBA8;
+        }
+    }
+
+    TextureCache::Format TextureCache::getFormat() const {
+        return static_cast<Format>(getHeader()->format);
+    }
+
+    int TextureCache::getLevelCount() const {
+        return static_cast<int>(getHeader()->levelCount);
+    }
+
+    TextureCache::Level TextureCache::getLevel(int index) const {
+        auto levelHeader = getLevelHeader(index);
+
+        return {
+                static_cast<GLsizei>(levelHeader->width),
+                static_cast<GLsizei>(levelHeader->height),
+                getData() + levelHeader->offset,
+                static_cast<GLsizei>(levelHeader->size)
+        };
+    }
+
+    TextureCache::TextureCache(std::unique_ptr<MappedFile> file) : m_file(std::move(file)) {}
+
+    TextureCache::TextureCache(std::vector<unsigned char> buffer) : m_buffer(std::move(buffer)) {}
+
+    const unsigned char *TextureCache::getData() const {
+        return m_file != nullptr ? m_file->getData() : m_buffer.data();
+    }
+
+    const TextureCache::Header *TextureCache::getHeader() const {
+        return reinterpret_cast<const Header *>(getData());
+    }
+
+    const TextureCache::LevelHeader *TextureCache::getLevelHeader(int index) const {
+        return reinterpret_cast<const LevelHeader *>(getData() + sizeof(Header)) + index;
+    }
+}
+
+static int getChannelCount(Engine::TextureCache::Format format) {
+    // (BC5 only keeps R and G, but SOIL can't decode to 2 channels.)
+    return format == Engine::TextureCache::Format::BC3 || format == Engine::TextureCache::Format::RGBA ? 4 : 3;
+}
+
+static std::vector<unsigned char> downsample(
+        const std::vector<unsigned char> &image,
+        int width,
+        int height,
+        int channels
+) {
+    auto newWidth = std::max(width / 2, 1);
+    auto newHeight = std::max(height / 2, 1);
+    std::vector<unsigned char> newImage(static_cast<size_t>(newWidth) * newHeight * channels);
+
+    // Box filter: Average the source pixels under each new one. (2x2 mostly, 3 wide at the end of an odd row.)
+    for (int y = 0; y < newHeight; y++) {
+        auto startY = y * height / newHeight;
+        auto endY = (y + 1) * height / newHeight;
+
+        for (int x = 0; x < newWidth; x++) {
+            auto startX = x * width / newWidth;
+            auto endX = (x + 1) * width / newWidth;
+            auto count = (endY - startY) * (endX - startX);
+
+            for (int channel = 0; channel < channels; channel++) {
+                auto sum = 0;
+
+                for (int sourceY = startY; sourceY < endY; sourceY++) {
+                    for (int sourceX = startX; sourceX < endX; sourceX++) {
+                        sum += image[(static_cast<size_t>(sourceY) * width + sourceX) * channels + channel];
+                    }
+                }
+
+                newImage[(static_cast<size_t>(y) * newWidth + x) * channels + channel] =
+                        static_cast<unsigned char>((sum + count / 2) / count);
+            }
+        }
+    }
+
+    return newImage;
+}
+
+static std::vector<unsigned char> encode(
+        const std::vector<unsigned char> &image,
+        int width,
+        int height,
+        int channels,
+        Engine::TextureCache::Format format
+) {
+    using Format = Engine::TextureCache::Format;
+
+    if (!Engine::TextureCache::isCompressed(format)) {
+        return image;
+    }
+
+    auto blockSize = format == Format::BC1 ? 8 : 16;
+    auto blockCountX = (width + 3) / 4;
+    auto blockCountY = (height + 3) / 4;
+    std::vector<unsigned char> output(static_cast<size_t>(blockCountX) * blockCountY * blockSize);
+    auto outputBlock = output.data();
+    unsigned char block[16 * 4];
+
+    for (int blockY = 0; blockY < blockCountY; blockY++) {
+        for (int blockX = 0; blockX < blockCountX; blockX++) {
+            // Gather the 4x4 pixels as RGBA. (Clamped, so a partial block at the edge repeats its last row/column.)
+            for (int i = 0; i < 16; i++) {
+                auto x = std::min(blockX * 4 + i % 4, width - 1);
+                auto y = std::min(blockY * 4 + i / 4, height - 1);
+                auto pixel = &image[(static_cast<size_t>(y) * width + x) * channels];
+
+                block[i * 4] = pixel[0];
+                block[i * 4 + 1] = pixel[1];
+                block[i * 4 + 2] = pixel[2];
+                block[i * 4 + 3] = channels == 4 ? pixel[3] : static_cast<unsigned char>(255);
+            }
+
+            if (format == Format::BC1) {
+                compress_DDS_color_block(4, block, outputBlock);
+            }
+            else if (format == Format::BC3) {
+                encodeAlphaBlock(block, 3, outputBlock);
+                compress_DDS_color_block(4, block, outputBlock + 8);
+            }
+            else {
+                // BC5 is 2 BC4 blocks, which are laid out exactly like DXT5's alpha block.
+                encodeAlphaBlock(block, 0, outputBlock);
+                encodeAlphaBlock(block, 1, outputBlock + 8);
+            }
+
+            outputBlock += blockSize;
+        }
+    }
+
+    return output;
+}
+
+static void encodeAlphaBlock(const unsigned char *block, int channel, unsigned char *output) {
+    unsigned char alphaBlock[16 * 4] = {};
+    auto isFlat = true;
+
+    // SOIL's encoder reads the alpha of the RGBA pixels.
+    for (int i = 0; i < 16; i++) {
+        alphaBlock[i * 4 + 3] = block[i * 4 + channel];
+        isFlat = isFlat && block[i * 4 + channel] == block[channel];
+    }
+
+    // SOIL divides by the range of the block, so write the flat ones directly: Both ends the value, all indices 0.
+    if (isFlat) {
+        std::memset(output, 0, 8);
+        output[0] = block[channel];
+        output[1] = block[channel];
+
+        return;
+    }
+
+    compress_DDS_alpha_block(alphaBlock, output);
+}
@@ -0,0 +1,93 @@
+#ifndef ENGINE_TEXTURE_CACHE_HPP
+#define ENGINE_TEXTURE_CACHE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Imported copy of an image: Its whole mip chain, already block-compressed, stored next to the source file.
+    // Keyed like MeshCache (source size, modification time and content hash), and memory-mapped on load,
+    // so the levels go to glCompressedTexImage2D() without decoding, filtering or compressing them again.
+    class TextureCache {
+    public:
+        // Bump this whenever the layout of the file, the filter or the encoders change.
+        static const uint32_t VERSION = 1;
+
+        enum class Format {
+            // DXT1: RGB, 4 bits per pixel. (Color maps.)
+            BC1,
+            // DXT5: RGBA, 8 bits per pixel. (Color maps with alpha.)
+            BC3,
+            // RGTC2: RG, 8 bits per pixel. (Normal maps: Rebuild Z in the shader.)
+            BC5,
+            // Uncompressed. (Fallbacks when S3TC isn't supported.)
+            RGB,
+            RGBA
+        };
+
+        struct Level {
+            GLsizei width;
+            GLsizei height;
+            const unsigned char *data;
+            GLsizei size;
+        };
+
+        // Map the cache of the source file. Returns nullptr if the cache is missing, broken, stale or of another format.
+        static std::unique_ptr<TextureCache> load(const std::string &sourcePath, Format format);
+
+        // Decode the source, build its mip chain (box filter, down to 1x1) and compress each level.
+        // Then write the cache. Failure to write is not fatal: We just import the source again next time.
+        static std::unique_ptr<TextureCache> import(const std::string &sourcePath, Format format);
+
+        // load(), or import() if there's no valid cache. (Safe to call from several threads for different sources.)
+        static std::unique_ptr<TextureCache> open(const std::string &sourcePath, Format format);
+
+        // One per format, so an image loaded in several formats keeps all of its caches.
+        static std::string getCachePath(const std::string &sourcePath, Format format);
+
+        static bool isCompressed(Format format);
+
+        // The internal format to upload the levels with.
+        static GLenum getInternalFormat(Format format);
+
+        Format getFormat() const;
+        int getLevelCount() const;
+
+        // Level 0 is the full image. (The data points into the mapping. Valid while this object is alive.)
+        Level getLevel(int index) const;
+
+    private:
+        struct Header {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceSize;
+            int64_t sourceTime;
+            uint64_t sourceHash;
+            uint32_t format;
+            uint32_t width;
+            uint32_t height;
+            uint32_t levelCount;
+        };
+
+        // One per level, after the header. (offset is from the start of the file.)
+        struct LevelHeader {
+            uint32_t width;
+            uint32_t height;
+            uint64_t offset;
+            uint64_t size;
+        };
+
+        // Either maps the file, or owns the bytes of a fresh import.
+        explicit TextureCache(std::unique_ptr<MappedFile> file);
+        explicit TextureCache(std::vector<unsigned char> buffer);
+
+        const unsigned char *getData() const;
+
+        const Header *getHeader() const;
+        const LevelHeader *getLevelHeader(int index) const;
+
+        std::unique_ptr<MappedFile> m_file;
+        std::vector<unsigned char> m_buffer;
+    };
+}
+
+#endif
@@ -0,0 +1,185 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    TextureLoader::TextureLoader(int threadCount) {
+        if (threadCount == ALL_THREADS) {
+            threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+
+        glGenBuffers(1, &m_bufferId);
+
+        for (int i = 0; i < std::max(threadCount, 1); i++) {
+            m_threadList.emplace_back(&TextureLoader::work, this);
+        }
+    }
+
+    TextureLoader::~TextureLoader() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_isStopping = true;
+        }
+
+        m_jobCondition.notify_all();
+
+        for (auto &thread: m_threadList) {
+            thread.join();
+        }
+
+        // Nothing to free if the context is already gone.
+        if (Backend::isContextCurrent()) {
+            glDeleteBuffers(1, &m_bufferId);
+        }
+    }
+
+    void TextureLoader::load(Texture &texture, const std::string &path, TextureCache::Format format) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_jobList.push_back({&texture, path, format});
+        }
+
+        m_jobCondition.notify_one();
+        m_pendingCount++;
+    }
+
+    int TextureLoader::poll() {
+        std::vector<Result> resultList;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            resultList.swap(m_resultList);
+        }
+
+        int count = 0;
+        std::exception_ptr error;
+
+        // Upload the rest of the batch even if a load failed. (Otherwise they're never uploaded, nor counted.)
+        for (auto &result: resultList) {
+            m_pendingCount--;
+
+            if (result.error) {
+                if (!error) {
+                    error = result.error;
+                }
+
+                continue;
+            }
+
+            upload(*result.texture, *result.cache);
+            count++;
+        }
+
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        return count;
+    }
+
+    void TextureLoader::finish() {
+        while (m_pendingCount > 0) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_resultCondition.wait(lock, [this] { return !m_resultList.empty(); });
+            }
+
+            poll();
+        }
+    }
+
+    int TextureLoader::getPendingCount() const {
+        return m_pendingCount;
+    }
+
+    void TextureLoader::work() {
+        while (true) {
+            Job job;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+
+                m_jobCondition.wait(lock, [this] { return m_isStopping || !m_jobList.empty(); });
+
+                if (m_isStopping) {
+                    return;
+                }
+
+                job = std::move(m_jobList.front());
+                m_jobList.pop_front();
+            }
+
+            Result result{job.texture, nullptr, nullptr};
+
+            // (The error is rethrown on the GL thread by poll().)
+            try {
+                result.cache = TextureCache::open(job.path, job.format);
+            }
+            catch (...) {
+                result.error = std::current_exception();
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                m_resultList.push_back(std::move(result));
+            }
+
+            m_resultCondition.notify_all();
+        }
+    }
+
+    void TextureLoader::upload(Texture &texture, const TextureCache &cache) {
+        GLsizeiptr size = 0;
+
+        for (int i = 0; i < cache.getLevelCount(); i++) {
+            size += cache.getLevel(i).size;
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_bufferId);
+
+        // Orphan the storage of the last upload, so the copy doesn't wait for the GPU to be done with it.
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+        auto data = static_cast<unsigned char *>(glMapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER,
+                0,
+                size,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+        ));
+
+        if (data != nullptr) {
+            // With an unpack buffer bound, the level pointers are offsets into it.
+            std::vector<const GLvoid *> levelDataList;
+            size_t offset = 0;
+
+            for (int i = 0; i < cache.getLevelCount(); i++) {
+                auto level = cache.getLevel(i);
+
+                std::memcpy(data + offset, level.data, static_cast<size_t>(level.size));
+                levelDataList.push_back(reinterpret_cast<const GLvoid *>(offset));
+                offset += level.size;
+            }
+
+            // (The contents are lost if unmapping fails. Then the levels are uploaded from the cache below.)
+            if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE) {
+                texture.setLevels(cache, levelDataList);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+                return;
+            }
+        }
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        std::vector<const GLvoid *> levelDataList;
+
+        for (int i = 0; i < cache.getLevelCount(); i++) {
+            levelDataList.push_back(cache.getLevel(i).data);
+        }
+
+        texture.setLevels(cache, levelDataList);
+    }
+}
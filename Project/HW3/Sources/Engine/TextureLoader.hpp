@@ -0,0 +1,75 @@
+#ifndef ENGINE_TEXTURE_LOADER_HPP
+#define ENGINE_TEXTURE_LOADER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Loads image textures in the background: A pool of threads opens their TextureCaches (importing the images
+    // which need it), and poll() uploads the finished ones on the GL thread through a pixel unpack buffer.
+    // Until then, each texture shows its fallback. (See Texture::isReady().)
+    //
+    // The textures must outlive the loader, or at least their loads.
+    class TextureLoader {
+    public:
+        // Use one thread per core.
+        static const int ALL_THREADS = -1;
+
+        // threadCount: ALL_THREADS or the number of threads. (Needs a current context, for the unpack buffer.)
+        explicit TextureLoader(int threadCount = ALL_THREADS);
+        // Drops the loads which haven't finished.
+        ~TextureLoader();
+
+        TextureLoader(const TextureLoader &) = delete;
+        TextureLoader &operator=(const TextureLoader &) = delete;
+
+        // Queue the image of the texture. (Texture's loading constructor calls this.)
+        void load(Texture &texture, const std::string &path, TextureCache::Format format);
+
+        // Upload the textures which are ready. Returns their number.
+        // Then rethrows the first error of the loads which failed. (Those textures keep their fallbacks.)
+        int poll();
+
+        // Wait for all the loads, and upload them. Rethrows like poll(), and can be called again to wait for the rest.
+        void finish();
+
+        // Number of the textures which weren't uploaded yet.
+        int getPendingCount() const;
+
+    private:
+        struct Job {
+            Texture *texture;
+            std::string path;
+            TextureCache::Format format;
+        };
+
+        struct Result {
+            Texture *texture;
+            std::unique_ptr<TextureCache> cache;
+            std::exception_ptr error;
+        };
+
+        void work();
+
+        void upload(Texture &texture, const TextureCache &cache);
+
+        std::vector<std::thread> m_threadList;
+
+        // Guards the queues and m_isStopping.
+        std::mutex m_mutex;
+        // Signaled on a new job, and on stopping.
+        std::condition_variable m_jobCondition;
+        // Signaled on a new result.
+        std::condition_variable m_resultCondition;
+
+        std::deque<Job> m_jobList;
+        std::vector<Result> m_resultList;
+        bool m_isStopping = false;
+
+        // Jobs queued but not uploaded yet. (GL thread only.)
+        int m_pendingCount = 0;
+
+        GLuint m_bufferId;
+    };
+}
+
+#endif
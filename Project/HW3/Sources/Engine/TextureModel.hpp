@@ -17,7 +17,7 @@ namespace Engine {
                 // Generate UVs using cylindrical coordinates.
                 auto polarPosition = glm::polar(position);
 
-                m_uvList.emplace_back(
+                this->m_uvList.emplace_back(
                         (polarPosition.x + halfPi) / pi,
                         (polarPosition.y + halfPi) / pi
                 );
@@ -28,14 +28,11 @@ namespace Engine {
             m_texture = texture;
         }
 
-    protected:
-        virtual void onCreate() {
-            T::onCreate();
-
-            this->initAttribute(2, 2, sizeof(glm::vec2));
-            this->setAttribute(2, m_uvList);
+        GLuint getTextureId() const override {
+            return m_texture == nullptr ? 0 : m_texture->getId();
         }
 
+    protected:
         virtual void onDraw() {
             T::onDraw();
 
@@ -43,12 +40,12 @@ namespace Engine {
                 throw std::runtime_error("Error: Texture is not set.");
             }
 
-            this->m_program->setUniform("textureUnit", m_texture->getUnit());
+            static const UniformHandle<GLint> textureUnit{"textureUnit"};
+
+            this->m_program->setUniform(textureUnit, m_texture->getUnit());
         }
 
         Texture *m_texture = nullptr;
-
-        std::vector<glm::vec2> m_uvList;
     };
 }
 
@@ -0,0 +1,61 @@
+#ifndef ENGINE_TRIPLE_BUFFER_HPP
+#define ENGINE_TRIPLE_BUFFER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Hands the latest value from one writer thread to one reader thread without blocking either.
+    // The writer fills getWriteBuffer() and publish()es it; the reader acquire()s the newest published one.
+    // Values published between two acquire()s are skipped.
+    //
+    // (3 buffers: The writer's, the reader's, and the published one in between. Swapped with 1 atomic.)
+    template<typename T>
+    class TripleBuffer {
+    public:
+        // All the buffers start as initial, so the reader sees it until the first publish().
+        explicit TripleBuffer(const T &initial = T()) :
+                m_bufferList{initial, initial, initial} {
+        }
+
+        TripleBuffer(const TripleBuffer &) = delete;
+        TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+        // (Writer.)
+        T &getWriteBuffer() {
+            return m_bufferList[m_writeIndex];
+        }
+
+        // Hand the write buffer to the reader, and take the one in between for the next write. (Writer.)
+        void publish() {
+            m_writeIndex = m_middle.exchange(m_writeIndex | NEW_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+
+        // Take the newest published buffer. Returns false if nothing was published since the last call. (Reader.)
+        bool acquire() {
+            if ((m_middle.load(std::memory_order_relaxed) & NEW_BIT) == 0) {
+                return false;
+            }
+
+            m_readIndex = m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+
+            return true;
+        }
+
+        // (Reader.)
+        const T &getReadBuffer() const {
+            return m_bufferList[m_readIndex];
+        }
+
+    private:
+        static const int INDEX_MASK = 3;
+        // Set if the buffer in between wasn't acquired yet.
+        static const int NEW_BIT = 4;
+
+        T m_bufferList[3];
+        int m_writeIndex = 0;
+        int m_readIndex = 1;
+        std::atomic<int> m_middle{2};
+    };
+}
+
+#endif
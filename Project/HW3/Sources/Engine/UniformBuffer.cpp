@@ -0,0 +1,54 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    UniformBuffer::UniformBuffer(Binding binding, GLsizeiptr size) :
+            m_binding(binding),
+            m_size(size),
+            m_id(0) {
+        glGenBuffers(1, &m_id);
+        glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+        glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(m_binding), m_id);
+    }
+
+    UniformBuffer::~UniformBuffer() {
+        // Nothing to free if the context is already gone.
+        if (!Backend::isContextCurrent()) {
+            return;
+        }
+
+        glDeleteBuffers(1, &m_id);
+    }
+
+    void UniformBuffer::update(const GLvoid *data) {
+        glBindBuffer(GL_UNIFORM_BUFFER, m_id);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, m_size, data);
+        glBindBufferBase(GL_UNIFORM_BUFFER, static_cast<GLuint>(m_binding), m_id);
+    }
+
+    GLuint UniformBuffer::getId() const {
+        return m_id;
+    }
+
+    UniformBuffer::Binding UniformBuffer::getBinding() const {
+        return m_binding;
+    }
+
+    void UniformBuffer::bindBlocks(GLuint programId) {
+        static const std::pair<const char *, Binding> blockList[] = {
+                {"LightBlock", LIGHT},
+                {"ViewBlock",  VIEW}
+        };
+
+        for (auto &block: blockList) {
+            auto index = glGetUniformBlockIndex(programId, block.first);
+
+            // (The program doesn't use this block.)
+            if (index == GL_INVALID_INDEX) {
+                continue;
+            }
+
+            glUniformBlockBinding(programId, index, static_cast<GLuint>(block.second));
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef ENGINE_UNIFORM_BUFFER_HPP
+#define ENGINE_UNIFORM_BUFFER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Uniform buffer object which is bound to a fixed binding point.
+    // (Every program connects the blocks with the known names to these points after linking. See Program.)
+    class UniformBuffer {
+    public:
+        enum Binding {
+            LIGHT = 0, // "LightBlock"
+            VIEW = 1 // "ViewBlock"
+        };
+
+        UniformBuffer(Binding binding, GLsizeiptr size);
+        ~UniformBuffer();
+
+        UniformBuffer(const UniformBuffer &) = delete;
+        UniformBuffer &operator=(const UniformBuffer &) = delete;
+
+        // Upload the data and bind the buffer to its binding point.
+        void update(const GLvoid *data);
+
+        GLuint getId() const;
+        Binding getBinding() const;
+
+        // Connect the uniform blocks of the program to the binding points.
+        static void bindBlocks(GLuint programId);
+
+    private:
+        Binding m_binding;
+        GLsizeiptr m_size;
+        GLuint m_id;
+    };
+}
+
+#endif
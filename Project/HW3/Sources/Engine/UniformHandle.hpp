@@ -0,0 +1,26 @@
+#ifndef ENGINE_UNIFORM_HANDLE_HPP
+#define ENGINE_UNIFORM_HANDLE_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Typed name of a uniform. The name is turned into an id once, so setting the value doesn't
+    // look up any string. The same handle works with every program. (See Program::setUniform().)
+    // ex. static const UniformHandle<glm::mat4> modelMatrix{"modelMatrix"};
+    template<typename T>
+    class UniformHandle {
+    public:
+        explicit UniformHandle(const std::string &name) :
+                m_id(Program::getUniformId(name)) {
+        }
+
+        int getId() const {
+            return m_id;
+        }
+
+    private:
+        int m_id;
+    };
+}
+
+#endif
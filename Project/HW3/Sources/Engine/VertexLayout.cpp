@@ -0,0 +1,188 @@
+#include "Engine.hpp"
+
+static const float MAX_HALF = 65504.0f;
+
+static GLsizei getPositionSize(Engine::VertexLayout::PositionFormat format);
+static GLsizei getNormalSize(Engine::VertexLayout::NormalFormat format);
+static GLsizei getUVSize(Engine::VertexLayout::UVFormat format);
+
+namespace Engine {
+    VertexLayout::VertexLayout(PositionFormat positionFormat, NormalFormat normalFormat, UVFormat uvFormat) :
+            m_positionFormat(positionFormat),
+            m_normalFormat(normalFormat),
+            m_uvFormat(uvFormat) {
+        m_normalOffset = getPositionSize(positionFormat);
+        m_uvOffset = m_normalOffset + getNormalSize(normalFormat);
+        m_stride = m_uvOffset + getUVSize(uvFormat);
+    }
+
+    VertexLayout VertexLayout::compact() {
+        return VertexLayout(POSITION_HALF, NORMAL_PACKED, UV_UNORM16);
+    }
+
+    VertexLayout VertexLayout::fit(
+            const glm::vec3 *positionData,
+            const glm::vec3 *normalData,
+            const glm::vec2 *uvData,
+            size_t count
+    ) const {
+        auto positionFormat = m_positionFormat;
+        auto normalFormat = (normalData == nullptr) ? NORMAL_NONE : m_normalFormat;
+        auto uvFormat = (uvData == nullptr) ? UV_NONE : m_uvFormat;
+
+        for (size_t i = 0; i < count; i++) {
+            if (positionFormat == POSITION_HALF
+                && glm::any(glm::greaterThan(glm::abs(positionData[i]), glm::vec3(MAX_HALF)))) {
+                positionFormat = POSITION_FLOAT;
+            }
+
+            // (Normals which aren't normalized keep their length as long as it fits.)
+            if (normalFormat == NORMAL_PACKED
+                && glm::any(glm::greaterThan(glm::abs(normalData[i]), glm::vec3(1.0f)))) {
+                normalFormat = NORMAL_FLOAT;
+            }
+
+            if (uvFormat == UV_UNORM16
+                && (glm::any(glm::lessThan(uvData[i], glm::vec2(0.0f)))
+                    || glm::any(glm::greaterThan(uvData[i], glm::vec2(1.0f))))) {
+                uvFormat = UV_FLOAT;
+            }
+        }
+
+        return VertexLayout(positionFormat, normalFormat, uvFormat);
+    }
+
+    std::vector<unsigned char> VertexLayout::pack(
+            const glm::vec3 *positionData,
+            const glm::vec3 *normalData,
+            const glm::vec2 *uvData,
+            size_t count
+    ) const {
+        std::vector<unsigned char> buffer(count * m_stride);
+
+        for (size_t i = 0; i < count; i++) {
+            auto vertex = buffer.data() + i * m_stride;
+
+            if (m_positionFormat == POSITION_FLOAT) {
+                std::memcpy(vertex, &positionData[i], sizeof(glm::vec3));
+            }
+            else {
+                uint16_t half[4] = {
+                        glm::packHalf1x16(positionData[i].x),
+                        glm::packHalf1x16(positionData[i].y),
+                        glm::packHalf1x16(positionData[i].z),
+                        0
+                };
+
+                std::memcpy(vertex, half, sizeof(half));
+            }
+
+            if (m_normalFormat == NORMAL_FLOAT) {
+                std::memcpy(vertex + m_normalOffset, &normalData[i], sizeof(glm::vec3));
+            }
+            else if (m_normalFormat == NORMAL_PACKED) {
+                uint32_t packed = glm::packSnorm3x10_1x2(glm::vec4(normalData[i], 0.0f));
+
+                std::memcpy(vertex + m_normalOffset, &packed, sizeof(packed));
+            }
+
+            if (m_uvFormat == UV_FLOAT) {
+                std::memcpy(vertex + m_uvOffset, &uvData[i], sizeof(glm::vec2));
+            }
+            else if (m_uvFormat == UV_UNORM16) {
+                uint16_t unorm[2] = {
+                        glm::packUnorm1x16(uvData[i].x),
+                        glm::packUnorm1x16(uvData[i].y)
+                };
+
+                std::memcpy(vertex + m_uvOffset, unorm, sizeof(unorm));
+            }
+        }
+
+        return buffer;
+    }
+
+    void VertexLayout::apply() const {
+        auto offset = [](GLsizei bytes) {
+            return reinterpret_cast<const void *>(static_cast<uintptr_t>(bytes));
+        };
+
+        glEnableVertexAttribArray(0);
+
+        if (m_positionFormat == POSITION_FLOAT) {
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, m_stride, offset(0));
+        }
+        else {
+            glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, m_stride, offset(0));
+        }
+
+        // (Disabled attributes read as (0, 0, 0, 1) in the shaders.)
+        if (m_normalFormat == NORMAL_NONE) {
+            glDisableVertexAttribArray(1);
+        }
+        else {
+            glEnableVertexAttribArray(1);
+
+            if (m_normalFormat == NORMAL_FLOAT) {
+                glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, m_stride, offset(m_normalOffset));
+            }
+            else {
+                glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, m_stride, offset(m_normalOffset));
+            }
+        }
+
+        if (m_uvFormat == UV_NONE) {
+            glDisableVertexAttribArray(2);
+        }
+        else {
+            glEnableVertexAttribArray(2);
+
+            if (m_uvFormat == UV_FLOAT) {
+                glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, m_stride, offset(m_uvOffset));
+            }
+            else {
+                glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_TRUE, m_stride, offset(m_uvOffset));
+            }
+        }
+    }
+
+    GLsizei VertexLayout::getStride() const {
+        return m_stride;
+    }
+
+    std::string VertexLayout::getKey() const {
+        static const char *positionNames[] = {"f32", "f16"};
+        static const char *normalNames[] = {"none", "f32", "snorm10"};
+        static const char *uvNames[] = {"none", "f32", "unorm16"};
+
+        return std::string("position=") + positionNames[m_positionFormat]
+               + ",normal=" + normalNames[m_normalFormat]
+               + ",uv=" + uvNames[m_uvFormat];
+    }
+}
+
+static GLsizei getPositionSize(Engine::VertexLayout::PositionFormat format) {
+    return (format == Engine::VertexLayout::POSITION_FLOAT) ? 12 : 8;
+}
+
+static GLsizei getNormalSize(Engine::VertexLayout::NormalFormat format) {
+    switch (format) {
+        case Engine::VertexLayout::NORMAL_FLOAT:
+            return 12;
+        case Engine::VertexLayout::NORMAL_PACKED:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+static GLsizei getUVSize(Engine::VertexLayout::UVFormat format) {
+    switch (format) {
+        case Engine::VertexLayout::UV_FLOAT:
+            return 8;
+        case Engine::VertexLayout::UV_UNORM16:
+            return 4;
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef ENGINE_VERTEX_LAYOUT_HPP
+#define ENGINE_VERTEX_LAYOUT_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // How the vertices of a mesh are stored: The attributes are interleaved in one VBO, each in its own format.
+    // (Attribute locations: 0 = position, 1 = normal, 2 = uv.)
+    class VertexLayout {
+    public:
+        enum PositionFormat {
+            POSITION_FLOAT, // 3 floats. (12 bytes)
+            POSITION_HALF // 3 half floats, padded to 8 bytes.
+        };
+
+        enum NormalFormat {
+            NORMAL_NONE,
+            NORMAL_FLOAT, // 3 floats. (12 bytes)
+            NORMAL_PACKED // GL_INT_2_10_10_10_REV, normalized. Only holds components in [-1, 1]. (4 bytes)
+        };
+
+        enum UVFormat {
+            UV_NONE,
+            UV_FLOAT, // 2 floats. (8 bytes)
+            UV_UNORM16 // 2 GL_UNSIGNED_SHORTs, normalized. Only holds UVs in [0, 1]. (4 bytes)
+        };
+
+        explicit VertexLayout(
+                PositionFormat positionFormat = POSITION_FLOAT,
+                NormalFormat normalFormat = NORMAL_FLOAT,
+                UVFormat uvFormat = UV_FLOAT
+        );
+
+        // Half float positions, packed normals and 16-bit UVs. (16 bytes per vertex, instead of 32.)
+        static VertexLayout compact();
+
+        // Returns the layout we can really use for the data: The attributes without data are dropped,
+        // and the compact formats fall back to floats if the data doesn't fit them.
+        VertexLayout fit(
+                const glm::vec3 *positionData,
+                const glm::vec3 *normalData,
+                const glm::vec2 *uvData,
+                size_t count
+        ) const;
+
+        // Convert the streams and interleave them. (nullptr for the attributes we don't have.)
+        std::vector<unsigned char> pack(
+                const glm::vec3 *positionData,
+                const glm::vec3 *normalData,
+                const glm::vec2 *uvData,
+                size_t count
+        ) const;
+
+        // Point the attributes to the bound VBO. (The VAO should be bound.)
+        void apply() const;
+
+        GLsizei getStride() const;
+
+        // Short name of the formats. (ex. For telling the meshes apart in MeshRegistry.)
+        std::string getKey() const;
+
+    private:
+        PositionFormat m_positionFormat;
+        NormalFormat m_normalFormat;
+        UVFormat m_uvFormat;
+
+        // Byte offsets in a vertex.
+        GLsizei m_normalOffset = 0;
+        GLsizei m_uvOffset = 0;
+        GLsizei m_stride = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,94 @@
+#include "Engine.hpp"
+
+static const GLuint EMPTY_SLOT = 0xFFFFFFFFu;
+
+static uint64_t hashVertex(const glm::vec3 &position, const glm::vec3 &normal, const glm::vec2 &uv);
+
+namespace Engine {
+    size_t VertexWelder::weld(
+            std::vector<glm::vec3> &positionList,
+            std::vector<glm::vec3> &normalList,
+            std::vector<glm::vec2> &uvList,
+            std::vector<GLuint> &indexList
+    ) {
+        auto count = positionList.size();
+
+        if (normalList.size() != count || uvList.size() != count) {
+            throw std::runtime_error("Error: Vertex streams have different lengths.");
+        }
+
+        // Open addressing with linear probing. Keep the load factor under 0.5.
+        size_t capacity = 16;
+
+        while (capacity < count * 2) {
+            capacity *= 2;
+        }
+
+        std::vector<GLuint> slotList(capacity, EMPTY_SLOT);
+        size_t mask = capacity - 1;
+        size_t uniqueCount = 0;
+
+        indexList.resize(count);
+
+        // Unique vertices are compacted to the front of the streams as we go.
+        // (The write position never passes the read position, so this works in place.)
+        for (size_t i = 0; i < count; i++) {
+            auto position = positionList[i];
+            auto normal = normalList[i];
+            auto uv = uvList[i];
+            auto slot = static_cast<size_t>(hashVertex(position, normal, uv)) & mask;
+
+            while (true) {
+                auto candidate = slotList[slot];
+
+                if (candidate == EMPTY_SLOT) {
+                    positionList[uniqueCount] = position;
+                    normalList[uniqueCount] = normal;
+                    uvList[uniqueCount] = uv;
+
+                    slotList[slot] = static_cast<GLuint>(uniqueCount);
+                    indexList[i] = static_cast<GLuint>(uniqueCount);
+                    uniqueCount++;
+                    break;
+                }
+
+                if (positionList[candidate] == position
+                    && normalList[candidate] == normal
+                    && uvList[candidate] == uv) {
+                    indexList[i] = candidate;
+                    break;
+                }
+
+                slot = (slot + 1) & mask;
+            }
+        }
+
+        positionList.resize(uniqueCount);
+        normalList.resize(uniqueCount);
+        uvList.resize(uniqueCount);
+
+        positionList.shrink_to_fit();
+        normalList.shrink_to_fit();
+        uvList.shrink_to_fit();
+
+        return uniqueCount;
+    }
+}
+
+static uint64_t hashVertex(const glm::vec3 &position, const glm::vec3 &normal, const glm::vec2 &uv) {
+    // Adding 0 turns -0 into +0, so that the values which compare equal also hash equal.
+    float valueList[8] = {
+            position.x + 0.0f, position.y + 0.0f, position.z + 0.0f,
+            normal.x + 0.0f, normal.y + 0.0f, normal.z + 0.0f,
+            uv.x + 0.0f, uv.y + 0.0f
+    };
+
+    uint64_t hash = Engine::hashBytes(valueList, sizeof(valueList));
+
+    // Spread the bits before the table masks out the low ones.
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 32;
+
+    return hash;
+}
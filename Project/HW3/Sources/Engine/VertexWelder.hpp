@@ -0,0 +1,22 @@
+#ifndef ENGINE_VERTEX_WELDER_HPP
+#define ENGINE_VERTEX_WELDER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Turns de-indexed vertex streams into indexed ones by merging the vertices whose
+    // (position, normal, uv) are exactly the same.
+    class VertexWelder {
+    public:
+        // Weld the streams in place and fill 'indexList'. (One index per original vertex.)
+        // Returns the number of unique vertices, which is the new size of the streams.
+        static size_t weld(
+                std::vector<glm::vec3> &positionList,
+                std::vector<glm::vec3> &normalList,
+                std::vector<glm::vec2> &uvList,
+                std::vector<GLuint> &indexList
+        );
+    };
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    ViewBuffer::ViewBuffer() :
+            m_cameraPosition(0.0f),
+            m_viewMatrix(1.0f),
+            m_projectionMatrix(1.0f),
+            m_lightViewMatrix(1.0f),
+            m_lightProjectionMatrix(1.0f),
+            m_isDirty(true),
+            m_buffer(UniformBuffer::Binding::VIEW, sizeof(ViewData)) {
+    }
+
+    void ViewBuffer::setCameraPosition(const glm::vec3 &position) {
+        m_cameraPosition = position;
+        m_isDirty = true;
+    }
+
+    void ViewBuffer::setViewMatrix(const glm::mat4 &matrix) {
+        m_viewMatrix = matrix;
+        m_isDirty = true;
+    }
+
+    void ViewBuffer::setProjectionMatrix(const glm::mat4 &matrix) {
+        m_projectionMatrix = matrix;
+        m_isDirty = true;
+    }
+
+    void ViewBuffer::setLightViewMatrix(const glm::mat4 &matrix) {
+        m_lightViewMatrix = matrix;
+        m_isDirty = true;
+    }
+
+    void ViewBuffer::setLightProjectionMatrix(const glm::mat4 &matrix) {
+        m_lightProjectionMatrix = matrix;
+        m_isDirty = true;
+    }
+
+    glm::vec3 ViewBuffer::getCameraPosition() const {
+        return m_cameraPosition;
+    }
+
+    glm::mat4 ViewBuffer::getViewMatrix() const {
+        return m_viewMatrix;
+    }
+
+    glm::mat4 ViewBuffer::getProjectionMatrix() const {
+        return m_projectionMatrix;
+    }
+
+    glm::mat4 ViewBuffer::getViewProjectionMatrix() const {
+        return m_projectionMatrix * m_viewMatrix;
+    }
+
+    glm::mat4 ViewBuffer::getLightViewProjectionMatrix() const {
+        return m_lightProjectionMatrix * m_lightViewMatrix;
+    }
+
+    void ViewBuffer::update() {
+        if (!m_isDirty) {
+            return;
+        }
+
+        ViewData data;
+
+        // (The products are computed once here instead of once per vertex.)
+        data.viewMatrix = m_viewMatrix;
+        data.projectionMatrix = m_projectionMatrix;
+        data.viewProjectionMatrix = getViewProjectionMatrix();
+        data.lightViewProjectionMatrix = getLightViewProjectionMatrix();
+        data.cameraPosition = m_cameraPosition;
+        data.padding = 0.0f;
+
+        m_buffer.update(&data);
+        m_isDirty = false;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef ENGINE_VIEW_BUFFER_HPP
+#define ENGINE_VIEW_BUFFER_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Per-frame camera constants shared by all programs. (Uniform block "ViewBlock" in the shaders.)
+    // Set the matrices, then call update() before the passes which use them.
+    class ViewBuffer {
+    public:
+        ViewBuffer();
+
+        // Setters.
+        void setCameraPosition(const glm::vec3 &position);
+        void setViewMatrix(const glm::mat4 &matrix);
+        void setProjectionMatrix(const glm::mat4 &matrix);
+        void setLightViewMatrix(const glm::mat4 &matrix);
+        void setLightProjectionMatrix(const glm::mat4 &matrix);
+
+        // Getters.
+        glm::vec3 getCameraPosition() const;
+        glm::mat4 getViewMatrix() const;
+        glm::mat4 getProjectionMatrix() const;
+        glm::mat4 getViewProjectionMatrix() const;
+        glm::mat4 getLightViewProjectionMatrix() const;
+
+        // Upload the constants if they changed.
+        void update();
+
+    private:
+        // std140 layout of the block. (Must match ViewBlock in the shaders.)
+        struct ViewData {
+            glm::mat4 viewMatrix;
+            glm::mat4 projectionMatrix;
+            glm::mat4 viewProjectionMatrix;
+            glm::mat4 lightViewProjectionMatrix;
+            glm::vec3 cameraPosition;
+            GLfloat padding;
+        };
+
+        static_assert(sizeof(ViewData) == 272, "ViewData doesn't match the std140 layout.");
+
+        glm::vec3 m_cameraPosition;
+        glm::mat4 m_viewMatrix;
+        glm::mat4 m_projectionMatrix;
+        glm::mat4 m_lightViewMatrix;
+        glm::mat4 m_lightProjectionMatrix;
+
+        bool m_isDirty;
+
+        UniformBuffer m_buffer;
+    };
+}
+
+#endif
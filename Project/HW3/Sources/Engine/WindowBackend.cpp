@@ -0,0 +1,64 @@
+#include "Engine.hpp"
+
+namespace Engine {
+    WindowBackend::WindowBackend(int width, int height, const std::string &title) {
+        // Initialize GLFW.
+        if (!glfwInit()) {
+            throw std::runtime_error("Error: Failed to initialize GLFW.");
+        }
+
+        glfwWindowHint(GLFW_SAMPLES, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+
+        // Create the window.
+        m_window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
+
+        if (m_window == nullptr) {
+            glfwTerminate();
+            throw std::runtime_error("Error: Failed to create the window.");
+        }
+
+        glfwMakeContextCurrent(m_window);
+        glfwSetInputMode(m_window, GLFW_STICKY_KEYS, GL_TRUE);
+
+        // Initialize GLEW.
+        glewExperimental = GL_TRUE;
+
+        if (glewInit() != GLEW_OK) {
+            glfwTerminate();
+            throw std::runtime_error("Error: Failed to initialize GLEW.");
+        }
+
+        setContextCurrent(true);
+    }
+
+    WindowBackend::~WindowBackend() {
+        setContextCurrent(false);
+        glfwTerminate();
+    }
+
+    void WindowBackend::present() {
+        glfwSwapBuffers(m_window);
+        glfwPollEvents();
+    }
+
+    bool WindowBackend::isClosed() const {
+        // ESCAPE key or X button.
+        return glfwGetKey(m_window, GLFW_KEY_ESCAPE) == GLFW_PRESS || glfwWindowShouldClose(m_window);
+    }
+
+    void WindowBackend::getFrameBufferSize(int &width, int &height) const {
+        glfwGetFramebufferSize(m_window, &width, &height);
+    }
+
+    GLFWwindow *WindowBackend::getWindow() const {
+        return m_window;
+    }
+
+    void WindowBackend::setSwapInterval(int interval) {
+        glfwSwapInterval(interval);
+    }
+}
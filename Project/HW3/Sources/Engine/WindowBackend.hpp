@@ -0,0 +1,27 @@
+#ifndef ENGINE_WINDOW_BACKEND_HPP
+#define ENGINE_WINDOW_BACKEND_HPP
+
+#include "Engine.hpp"
+
+namespace Engine {
+    // Renders into a GLFW window.
+    class WindowBackend : public Backend {
+    public:
+        WindowBackend(int width, int height, const std::string &title);
+        ~WindowBackend() override;
+
+        WindowBackend(const WindowBackend &) = delete;
+        WindowBackend &operator=(const WindowBackend &) = delete;
+
+        void present() override;
+        bool isClosed() const override;
+        void getFrameBufferSize(int &width, int &height) const override;
+        GLFWwindow *getWindow() const override;
+        void setSwapInterval(int interval) override;
+
+    private:
+        GLFWwindow *m_window;
+    };
+}
+
+#endif
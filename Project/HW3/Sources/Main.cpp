@@ -13,18 +13,34 @@ static const GLsizei INITIAL_HEIGHT = 500;
 static std::string TEXTURE_PATH = "Resources/Images/"; // NOLINT
 static std::string SHADER_PATH = "Resources/Shaders/"; // NOLINT
 static std::string MODEL_PATH = "Resources/Models/"; // NOLINT
+static const int SINGLE_THREAD = Engine::OBJParser::SINGLE_THREAD;
+// Instances of the cat model.
+static const int MY_CAT = 0;
+static const int LIGHT_CAT = 1;
+static const int FIRST_CAT = 2;
+static const int SECOND_CAT = 3;
+// Groups of the scene tree proxies.
+static const uint32_t DRAW_GROUP = 1u << 0;
+static const uint32_t SHADOW_GROUP = 1u << 1;
+static const uint32_t SELECT_GROUP = 1u << 2;
+// Start of the main light. (Circles around the y axis.)
+static const glm::vec3 MAIN_LIGHT_POSITION{3.0f, 6.0f, 3.0f}; // NOLINT
+// Speed of the main light. (Radians per second)
+static const float MAIN_LIGHT_SPEED = 0.12f;
+static const Engine::VertexLayout COMPACT_LAYOUT = Engine::VertexLayout::compact(); // NOLINT
 
 class MyRenderer : public Engine::Renderer {
 private:
-    // Textures.
-    Engine::Texture skyTexture{TEXTURE_PATH + "DarkSky.png"};
-    Engine::Texture jesusTexture{TEXTURE_PATH + "Jesus.png"};
-    Engine::Texture catLightTexture{TEXTURE_PATH + "CatLight.png"};
-    Engine::Texture catDarkTexture{TEXTURE_PATH + "CatDark.png"};
-    Engine::Texture chopperTexture{TEXTURE_PATH + "Chopper.png"};
-    Engine::Texture landTexture{TEXTURE_PATH + "Land.png"};
-    Engine::Texture lightTexture{TEXTURE_PATH + "Yellow.png"};
-    Engine::Texture brushTexture{TEXTURE_PATH + "Brush.png"};
+    // Textures. (Decoded on the loader's threads. Drawn with their fallbacks until they arrive.)
+    Engine::TextureLoader textureLoader;
+    Engine::Texture skyTexture{textureLoader, TEXTURE_PATH + "DarkSky.png"};
+    Engine::Texture jesusTexture{textureLoader, TEXTURE_PATH + "Jesus.png"};
+    Engine::Texture catLightTexture{textureLoader, TEXTURE_PATH + "CatLight.png"};
+    Engine::Texture catDarkTexture{textureLoader, TEXTURE_PATH + "CatDark.png"};
+    Engine::Texture chopperTexture{textureLoader, TEXTURE_PATH + "Chopper.png"};
+    Engine::Texture landTexture{textureLoader, TEXTURE_PATH + "Land.png"};
+    Engine::Texture lightTexture{textureLoader, TEXTURE_PATH + "Yellow.png"};
+    Engine::Texture brushTexture{textureLoader, TEXTURE_PATH + "Brush.png"};
 
     // Frame buffers.
     // -- For shadow mapping.
@@ -63,7 +79,7 @@ private:
     // -- Main light. This light makes the shadows. (Yellow, point light)
     Engine::Light mainLight{
             Engine::Light::Type::POINT,
-            glm::vec3(3.0f, 6.0f, 3.0f),
+            MAIN_LIGHT_POSITION,
             glm::vec3(0.0f, -1.0f, 0.0f),
             glm::vec3(0.0f, 0.0f, 0.0f),
             glm::vec3(1.0f, 1.0f, 0.0f),
@@ -72,6 +88,9 @@ private:
             0.03f
     };
 
+    // -- Light list shared by the programs.
+    Engine::LightBuffer lightBuffer;
+
     // Models.
     // -- Skybox.
     App::SkyModel skyModel{
@@ -85,72 +104,106 @@ private:
             0.0f
     };
 
-    // -- General models.
-    App::ExternalModel jesusModel{MODEL_PATH + "Jesus.obj"};
-    App::ExternalModel catModel1{MODEL_PATH + "Cat.obj"};
-    App::ExternalModel catModel2{MODEL_PATH + "Cat.obj"};
-    App::ExternalModel chopperModel{MODEL_PATH + "Chopper.obj"};
-
-    // -- My character.
-    App::ExternalModel myModel{MODEL_PATH + "Cat.obj"};
+    // -- General models. (Stored with the compact vertex layout.)
+    App::ExternalModel jesusModel{MODEL_PATH + "Jesus.obj", SINGLE_THREAD, COMPACT_LAYOUT};
+    App::ExternalModel chopperModel{MODEL_PATH + "Chopper.obj", SINGLE_THREAD, COMPACT_LAYOUT};
 
-    // -- Light model. (Yellow cat)
-    App::ExternalModel lightModel{MODEL_PATH + "Cat.obj"};
+    // -- Cats, drawn with one instanced draw call.
+    // (My character, the light model(yellow cat) and two more cats. See MY_CAT, LIGHT_CAT, ...)
+    App::InstancedExternalModel catModels{MODEL_PATH + "Cat.obj", SINGLE_THREAD, COMPACT_LAYOUT};
 
     // -- Simple rectangle. We'll draw the models on this and apply post processing.
     App::DisplayModel displayModel{1.8f};
 
-    // Model groups.
+    // Model groups. (Put into the scene tree at the start.)
     std::vector<App::GeneralModel *> drawModelGroup{
-            &myModel,
-            &lightModel,
+            &catModels,
             &skyModel,
             &landModel,
             &jesusModel,
-            &catModel1,
-            &catModel2,
             &chopperModel
     };
 
     std::vector<App::GeneralModel *> shadowModelGroup{
-            &myModel,
-            &lightModel,
+            &catModels,
             &jesusModel,
-            &catModel1,
-            &catModel2,
             &chopperModel
     };
 
-    std::vector<App::GeneralModel *> selectModelGroup{
-            &jesusModel,
-            &catModel1,
-            &catModel2,
-            &chopperModel,
-            &landModel
+    // Selectable models. (instanceIndex >= 0: An instance of catModels.)
+    struct Selectable {
+        App::GeneralModel *model;
+        int instanceIndex;
+        int proxyId;
+    };
+
+    std::vector<Selectable> selectModelGroup{
+            {&jesusModel,   -1,         -1},
+            {&catModels,    FIRST_CAT,  -1},
+            {&catModels,    SECOND_CAT, -1},
+            {&chopperModel, -1,         -1},
+            {&landModel,    -1,         -1}
     };
 
     int selectedModelIndex = 0;
 
-    // Matrices.
-    // -- Light's projection matrix & view matrix for shadow mapping.
-    glm::mat4 lightProjectionMatrix;
-    glm::mat4 lightViewMatrix;
+    // Bounding volume hierarchy over the models & the selectable objects.
+    // (Culling and selection query this instead of scanning the groups.)
+    Engine::SceneTree sceneTree;
+    // Proxies of the models in drawModelGroup.
+    std::vector<int> modelProxyList;
+
+    // Draws of the frame, sorted per pass.
+    Engine::RenderQueue renderQueue;
+
+    // Screen captures. (Saved 1 ~ 2 frames after the request.)
+    Engine::AsyncReadback readback;
+    bool isCaptureRequested = false;
+    int captureCount = 0;
+    int screenWidth = INITIAL_WIDTH;
+    int screenHeight = INITIAL_HEIGHT;
+
+    // Matrices. (Eye's & light's view/projection matrices, shared by the programs.)
+    Engine::ViewBuffer viewBuffer;
+
+    // State of the moving things after a step, as onDraw() needs it.
+    struct SceneState {
+        glm::vec3 cameraPosition;
+        glm::vec3 cameraDirection;
+        // My character's angle around the y axis.
+        float myAngle;
+        glm::vec3 mainLightPosition;
+        GLint resolution;
+    };
 
-    // -- Eye's projection matrix & view matrix for rendering.
-    glm::mat4 projectionMatrix;
-    glm::mat4 viewMatrix;
+    // Handed from onUpdate() to onDraw(): The last two states, drawn in between.
+    struct Snapshot {
+        SceneState previous;
+        SceneState current;
+        // End of the step which made current.
+        double stepTime;
+    };
 
-    // Movement.
+    // Input. (Set by the key callbacks, read by onUpdate(). The speeds are per second.)
+    std::mutex inputMutex;
     glm::vec2 myMoveSpeed{0.0f, 0.0f};
     glm::vec2 myAngleSpeed{0.0f, 0.0f};
+    float resolutionSpeed = 0.0f;
+
+    // Simulation. (Only onUpdate() touches these, on the simulation thread if the update is threaded.)
     glm::vec2 myPosition{-2.0f, 2.0f};
     glm::vec2 myAngle{glm::radians(150.0f), 0.3f};
+    float mainLightAngle = 0.0f;
+    // -- Kept as float, since a step changes it by less than 1.
+    float resolution = 0.0f;
+    SceneState lastState;
 
-    // Resolution.
-    int resolutionSpeed = 0;
+    // The newest snapshot for onDraw(), without locks.
+    Engine::TripleBuffer<Snapshot> snapshotBuffer;
 
 public:
-    MyRenderer() : Engine::Renderer(INITIAL_WIDTH, INITIAL_HEIGHT, "Homework 3: 20130295 - Hunmin Park") {
+    explicit MyRenderer(Engine::Backend::Type backendType = Engine::Backend::WINDOW) :
+            Engine::Renderer(INITIAL_WIDTH, INITIAL_HEIGHT, "Homework 3: 20130295 - Hunmin Park", backendType) {
         std::cout
                 << "+-----------------------------+\n"
                 << "| CS580 Homework Assignment 3 |\n"
@@ -163,19 +216,23 @@ public:
         // -- General models.
         jesusModel.setModelMatrix(glm::scale(glm::mat4(1.0f), glm::vec3(0.7f)));
 
-        catModel1.setModelMatrix(multiplyMatrices(
+        // -- Cats. (The texture index chooses one of the instance textures below.)
+        catModels.addInstance(glm::mat4(1.0f), 0); // MY_CAT
+        catModels.addInstance(glm::mat4(1.0f), 1); // LIGHT_CAT
+
+        catModels.addInstance(multiplyMatrices(
                 {
                         glm::translate(glm::vec3(3.0f, 0.0f, 0.0f)),
                         glm::scale(glm::mat4(1.0f), glm::vec3(2.0f))
                 }
-        ));
+        ), 2); // FIRST_CAT
 
-        catModel2.setModelMatrix(multiplyMatrices(
+        catModels.addInstance(multiplyMatrices(
                 {
                         glm::translate(glm::vec3(0.0f, 0.0f, 3.0f)),
                         glm::scale(glm::mat4(1.0f), glm::vec3(2.0f))
                 }
-        ));
+        ), 0); // SECOND_CAT
 
         chopperModel.setModelMatrix(multiplyMatrices(
                 {
@@ -186,66 +243,115 @@ public:
                 }
         ));
 
-        myModel.setTexture(&catLightTexture);
-        lightModel.setTexture(&lightTexture);
+        catModels.setTexture(&catLightTexture);
+        catModels.setInstanceTexture(0, &catLightTexture);
+        catModels.setInstanceTexture(1, &lightTexture);
+        catModels.setInstanceTexture(2, &catDarkTexture);
         skyModel.setTexture(&skyTexture);
         landModel.setTexture(&landTexture);
         jesusModel.setTexture(&jesusTexture);
-        catModel1.setTexture(&catDarkTexture);
-        catModel2.setTexture(&catLightTexture);
         chopperModel.setTexture(&chopperTexture);
 
         for (auto model: drawModelGroup) {
             model->setBrushTexture(&brushTexture);
             model->setShadowMap(depthFrameBuffer.getDepthTexture());
-            model->setLight(0, backgroundLight);
-            model->setLight(1, mainLight);
         }
 
+        // -- Lights.
+        lightBuffer.setLight(0, backgroundLight);
+        lightBuffer.setLight(1, mainLight);
+
         // -- Display model.
         displayModel.setTexture(drawFrameBuffer.getColorTexture());
         displayModel.setDepthMap(drawFrameBuffer.getDepthTexture());
         displayModel.setProgram(&displayProgram);
 
+        // -- Scene tree. (The bounds are empty until the meshes are uploaded, so the proxies are moved every frame.)
+        for (auto model: drawModelGroup) {
+            auto isShadowed = std::find(shadowModelGroup.begin(), shadowModelGroup.end(), model)
+                              != shadowModelGroup.end();
+
+            modelProxyList.push_back(sceneTree.insert(
+                    model->getBounds(),
+                    model,
+                    -1,
+                    DRAW_GROUP | (isShadowed ? SHADOW_GROUP : 0u)
+            ));
+        }
+
+        for (auto &selectable: selectModelGroup) {
+            selectable.proxyId = sceneTree.insert(
+                    getSelectableBounds(selectable),
+                    selectable.model,
+                    selectable.instanceIndex,
+                    SELECT_GROUP
+            );
+        }
+
+        // -- First snapshot. (Drawn until the first update.)
+        resolution = static_cast<float>(displayModel.getResolution());
+        lastState = makeSceneState();
+        publishSnapshot(0.0);
+
         // -- Select 0th model at the start.
-        selectModelGroup[selectedModelIndex]->select(true);
+        select(selectModelGroup[selectedModelIndex], true);
 
         // OpenGL settings.
         // -- Depth test.
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
+        Engine::GLState::setDepthTest(true, GL_LESS);
 
         // -- Backface culling.
-        glEnable(GL_CULL_FACE);
-        glCullFace(GL_BACK);
+        Engine::GLState::setCullFace(true, GL_BACK);
     }
 
-private:
-    void onDraw() override {
-        // Change the resolution.
-        displayModel.setResolution(displayModel.getResolution() + resolutionSpeed);
+    // Capture the next frame.
+    void capture() {
+        isCaptureRequested = true;
+    }
 
-        // Rotate the main light.
-        mainLight.position = glm::rotate(mainLight.position, 0.002f, glm::vec3(0.0f, 1.0f, 0.0f));
+    // Wait for the captures in flight and save them.
+    void finishCaptures() {
+        readback.finish();
+    }
 
-        lightModel.setModelMatrix(glm::translate(glm::scale(glm::vec3(0.5f)), mainLight.position));
+    // Wait for the textures which are still loading.
+    void finishTextures() {
+        textureLoader.finish();
+    }
 
-        lightViewMatrix = glm::lookAt(
-                mainLight.position,
-                glm::vec3(0.0f, 0.0f, 0.0f),
-                glm::vec3(0.0f, 0.0f, 1.0f)
-        );
+    // Print the percentiles, and save the frames as a Chrome trace & CSV.
+    void saveProfile() {
+        auto &profiler = getProfiler();
 
-        for (auto model: drawModelGroup) {
-            model->setLight(1, mainLight);
-            model->setLightViewMatrix(lightViewMatrix);
+        profiler.printReport(std::cout);
+        profiler.exportTrace("Profile.json");
+        profiler.exportCSV("Profile.csv");
+
+        std::cout << "Saved Profile.json, Profile.csv.\n";
+    }
+
+private:
+    void onUpdate(float dt) override {
+        glm::vec2 moveSpeed, angleSpeed;
+        float resolutionChange;
+
+        {
+            std::lock_guard<std::mutex> lock(inputMutex);
+            moveSpeed = myMoveSpeed;
+            angleSpeed = myAngleSpeed;
+            resolutionChange = resolutionSpeed * dt;
         }
 
-        // Move & rotate the camera.
-        // -- Rotate the camera.
+        // Change the resolution.
+        resolution = glm::clamp(resolution + resolutionChange, 10.0f, 1210.0f);
+
+        // Rotate the main light.
+        mainLightAngle += MAIN_LIGHT_SPEED * dt;
+
+        // Rotate the camera.
         float yAngleLimit = glm::radians(60.0f);
 
-        myAngle += myAngleSpeed;
+        myAngle += angleSpeed * dt;
 
         if (myAngle.y > yAngleLimit) {
             myAngle.y = yAngleLimit;
@@ -255,106 +361,189 @@ private:
             myAngle.y = -yAngleLimit;
         }
 
-        glm::vec3 cameraDirection = glm::rotate(
-                glm::rotate(glm::vec3(0.0f, 0.0f, 1.0f), myAngle.y, glm::vec3(1.0f, 0.0f, 0.0f)),
-                myAngle.x,
-                glm::vec3(0.0f, 1.0f, 0.0f)
-        );
+        // Move the camera.
+        glm::vec3 moveDirection = glm::normalize(getCameraDirection(myAngle));
 
-        // -- Move the camera.
-        glm::vec3 moveDirection = glm::normalize(cameraDirection);
+        myPosition += (glm::vec2(moveDirection.x, moveDirection.z) * moveSpeed.y
+                       + glm::vec2(moveDirection.z, -moveDirection.x) * moveSpeed.x) * dt;
 
-        myPosition += glm::vec2(moveDirection.x, moveDirection.z) * myMoveSpeed.y
-                      + glm::vec2(moveDirection.z, -moveDirection.x) * myMoveSpeed.x;
+        publishSnapshot(getStepTime());
+    }
 
-        glm::vec3 cameraPosition = glm::vec3(myPosition.x, 2.0f, myPosition.y);
+    void onDraw() override {
+        auto &profiler = getProfiler();
 
-        for (auto model: drawModelGroup) {
-            model->setCameraPosition(cameraPosition);
-        }
+        profiler.beginScope("Scene");
+
+        // Upload the textures which arrived, and save the captures which arrived.
+        textureLoader.poll();
+        readback.poll();
+
+        // Place the moving things between the last two states of the newest snapshot.
+        snapshotBuffer.acquire();
+
+        auto &snapshot = snapshotBuffer.getReadBuffer();
+        auto alpha = getInterpolation(snapshot.stepTime);
+        auto &previous = snapshot.previous;
+        auto &current = snapshot.current;
+
+        displayModel.setResolution(current.resolution);
+
+        // Place the main light.
+        mainLight.position = glm::mix(previous.mainLightPosition, current.mainLightPosition, alpha);
+
+        catModels.setInstanceMatrix(LIGHT_CAT, glm::translate(glm::scale(glm::vec3(0.5f)), mainLight.position));
+
+        viewBuffer.setLightViewMatrix(glm::lookAt(
+                mainLight.position,
+                glm::vec3(0.0f, 0.0f, 0.0f),
+                glm::vec3(0.0f, 0.0f, 1.0f)
+        ));
+
+        lightBuffer.setLight(1, mainLight);
+        lightBuffer.update();
+
+        // Place the camera.
+        glm::vec3 cameraDirection = glm::mix(previous.cameraDirection, current.cameraDirection, alpha);
+        glm::vec3 cameraPosition = glm::mix(previous.cameraPosition, current.cameraPosition, alpha);
+
+        viewBuffer.setCameraPosition(cameraPosition);
 
         // -- Let my character follow the camera.
-        myModel.setModelMatrix(multiplyMatrices(
+        catModels.setInstanceMatrix(MY_CAT, multiplyMatrices(
                 {
                         glm::translate(glm::vec3(cameraPosition.x, 0.0f, cameraPosition.z)),
-                        glm::rotate(glm::mat4(1.0f), myAngle.x, glm::vec3(0.0f, 1.0f, 0.0f))
+                        glm::rotate(
+                                glm::mat4(1.0f),
+                                glm::mix(previous.myAngle, current.myAngle, alpha),
+                                glm::vec3(0.0f, 1.0f, 0.0f)
+                        )
                 }
         ));
 
         // -- Update the view matrix.
-        viewMatrix = glm::lookAt(
+        viewBuffer.setViewMatrix(glm::lookAt(
                 cameraPosition,
                 cameraPosition + cameraDirection,
                 glm::vec3(0.0f, 1.0f, 0.0f)
-        );
+        ));
 
-        for (auto model: drawModelGroup) {
-            model->setViewMatrix(viewMatrix);
+        // -- Upload the matrices once for all the passes.
+        viewBuffer.update();
+
+        // Update the scene tree. (Only the proxies which left their fat boxes change the tree.)
+        for (size_t i = 0; i < drawModelGroup.size(); i++) {
+            sceneTree.move(modelProxyList[i], drawModelGroup[i]->getBounds());
+        }
+
+        for (auto &selectable: selectModelGroup) {
+            sceneTree.move(selectable.proxyId, getSelectableBounds(selectable));
         }
 
-        // Render.
+        // Queue the draws. (Shadow pass: Grouped by state, main pass: Front to back.)
+        // -- The models outside of the light's volume / the camera's view are culled.
+        renderQueue.clear();
+        renderQueue.setViewPoint(cameraPosition, 100.0f);
+
+        renderQueue.submit(
+                Engine::RenderQueue::Pass::SHADOW,
+                sceneTree,
+                SHADOW_GROUP,
+                &depthProgram,
+                Engine::Frustum(viewBuffer.getLightViewProjectionMatrix())
+        );
+
+        renderQueue.submit(
+                Engine::RenderQueue::Pass::OPAQUE,
+                sceneTree,
+                DRAW_GROUP,
+                &drawProgram,
+                Engine::Frustum(viewBuffer.getViewProjectionMatrix())
+        );
+
+        renderQueue.sort();
+
+        profiler.endScope();
+
+        // Render. (Each pass is timed on the CPU & the GPU.)
         // -- First pass: Create the shadow map.
+        profiler.beginScope("Shadow");
         depthFrameBuffer.bind();
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // NOLINT
         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
 
-        for (auto model: shadowModelGroup) {
-            model->setProgram(&depthProgram);
-            model->draw();
-        }
+        renderQueue.draw(Engine::RenderQueue::Pass::SHADOW);
 
         depthFrameBuffer.unbind();
+        profiler.endScope();
 
         // -- Second pass: Render the models on the frame buffer.
+        profiler.beginScope("Draw");
         drawFrameBuffer.bind();
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // NOLINT
         glClearColor(0.2f, 0.2f, 0.2f, 0.0f);
 
-        for (auto model: drawModelGroup) {
-            model->setProgram(&drawProgram);
-            model->draw();
-        }
+        renderQueue.draw(Engine::RenderQueue::Pass::OPAQUE);
 
         drawFrameBuffer.unbind();
+        profiler.endScope();
 
         // -- Third pass: Render the frame buffer on a rectangle.
+        profiler.beginScope("Display");
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // NOLINT
         glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
         displayModel.draw();
+        profiler.endScope();
+
+        // Capture the frame without waiting for it.
+        if (isCaptureRequested) {
+            auto path = "Capture" + std::to_string(captureCount++) + ".ppm";
+
+            readback.request(
+                    nullptr,
+                    Engine::AsyncReadback::COLOR,
+                    0, 0, screenWidth, screenHeight,
+                    [path](const Engine::AsyncReadback::Result &result) {
+                        saveCapture(path, result);
+                    }
+            );
+
+            isCaptureRequested = false;
+        }
     }
 
     void onSizeChange(int width, int height) override {
         // Resize the viewport.
-        glViewport(0, 0, width, height);
+        Engine::GLState::setViewport(0, 0, width, height);
+
+        screenWidth = width;
+        screenHeight = height;
 
         // Resize the frame buffers.
         drawFrameBuffer.setSize(width, height);
         depthFrameBuffer.setSize(width, height);
 
         // Reset the projection matrices.
-        projectionMatrix = glm::perspective(
+        viewBuffer.setProjectionMatrix(glm::perspective(
                 90.0f,
                 static_cast<GLfloat>(width) / static_cast<GLfloat>(height),
                 0.5f,
                 100.0f
-        );
+        ));
 
-        lightProjectionMatrix = glm::ortho(
+        viewBuffer.setLightProjectionMatrix(glm::ortho(
                 -10.0f, 10.0f,
                 -10.0f, 10.0f,
                 -20.0f, 20.0f
-        );
-
-        for (auto model: drawModelGroup) {
-            model->setProjectionMatrix(projectionMatrix);
-            model->setLightProjectionMatrix(lightProjectionMatrix);
-        }
+        ));
     }
 
     void onKeyPress(int key) override {
-        float v = 0.006f;
-        float a = 0.001f;
-        int r = 2;
+        // (Per second.)
+        float v = 0.36f;
+        float r = 120.0f;
+
+        std::lock_guard<std::mutex> lock(inputMutex);
 
         switch (key) {
         case GLFW_KEY_H:
@@ -362,10 +551,14 @@ private:
             break;
         case GLFW_KEY_R:
             // Select the next model.
-            selectModelGroup[selectedModelIndex]->select(false);
+            select(selectModelGroup[selectedModelIndex], false);
             selectedModelIndex = static_cast<int>((selectedModelIndex + 1) % selectModelGroup.size());
-            selectModelGroup[selectedModelIndex]->select(true);
+            select(selectModelGroup[selectedModelIndex], true);
 
+            break;
+        case GLFW_KEY_F:
+            // Select the model nearest to my character.
+            selectNearest();
             break;
         case GLFW_KEY_W:
             // Move front.
@@ -407,12 +600,26 @@ private:
             // Lower resolution.
             resolutionSpeed = -r;
             break;
+        case GLFW_KEY_C:
+            // Capture the screen.
+            isCaptureRequested = true;
+            break;
+        case GLFW_KEY_G:
+            // Print the GL state & culling statistics of the last frame.
+            printStateCounters();
+            break;
+        case GLFW_KEY_T:
+            // Print & save the frame times.
+            saveProfile();
+            break;
         default:
             break;
         }
     }
 
     void onKeyRelease(int key) override {
+        std::lock_guard<std::mutex> lock(inputMutex);
+
         switch (key) {
         case GLFW_KEY_W:
         case GLFW_KEY_S:
@@ -432,7 +639,7 @@ private:
             break;
         case GLFW_KEY_U:
         case GLFW_KEY_I:
-            resolutionSpeed = 0;
+            resolutionSpeed = 0.0f;
             break;
         default:
             break;
@@ -440,16 +647,129 @@ private:
     }
 
 private:
+    void select(const Selectable &selectable, bool isSelected) {
+        if (selectable.instanceIndex < 0) {
+            selectable.model->select(isSelected);
+        }
+        else {
+            catModels.setInstanceSelected(selectable.instanceIndex, isSelected);
+        }
+    }
+
+    // State of the simulation, for drawing.
+    SceneState makeSceneState() {
+        SceneState state;
+
+        state.cameraPosition = glm::vec3(myPosition.x, 2.0f, myPosition.y);
+        state.cameraDirection = getCameraDirection(myAngle);
+        state.myAngle = myAngle.x;
+        state.mainLightPosition = glm::rotate(MAIN_LIGHT_POSITION, mainLightAngle, glm::vec3(0.0f, 1.0f, 0.0f));
+        state.resolution = static_cast<GLint>(resolution);
+
+        return state;
+    }
+
+    // Hand the last two states to onDraw().
+    void publishSnapshot(double stepTime) {
+        auto state = makeSceneState();
+        auto &snapshot = snapshotBuffer.getWriteBuffer();
+
+        snapshot.previous = lastState;
+        snapshot.current = state;
+        snapshot.stepTime = stepTime;
+        snapshotBuffer.publish();
+
+        lastState = state;
+    }
+
+    // Direction the camera looks at with the angles. (x: Around the y axis, y: Up & down)
+    static glm::vec3 getCameraDirection(const glm::vec2 &angle) {
+        return glm::rotate(
+                glm::rotate(glm::vec3(0.0f, 0.0f, 1.0f), angle.y, glm::vec3(1.0f, 0.0f, 0.0f)),
+                angle.x,
+                glm::vec3(0.0f, 1.0f, 0.0f)
+        );
+    }
+
+    // Bounds of the selectable object in world space.
+    Engine::Bounds getSelectableBounds(const Selectable &selectable) {
+        if (selectable.instanceIndex < 0) {
+            return selectable.model->getBounds();
+        }
+
+        return catModels.getInstanceBounds(selectable.instanceIndex);
+    }
+
+    void selectNearest() {
+        auto position = snapshotBuffer.getReadBuffer().current.cameraPosition;
+        auto cameraPosition = glm::vec3(position.x, 0.0f, position.z);
+        auto proxyId = sceneTree.findNearest(cameraPosition, SELECT_GROUP);
+
+        for (size_t i = 0; i < selectModelGroup.size(); i++) {
+            if (selectModelGroup[i].proxyId == proxyId) {
+                select(selectModelGroup[selectedModelIndex], false);
+                selectedModelIndex = static_cast<int>(i);
+                select(selectModelGroup[selectedModelIndex], true);
+
+                break;
+            }
+        }
+    }
+
     void printKeymaps() {
         std::cout
                 << "\n"
                 << "- H(h): Print the keymaps.\n"
                 << "- R(r): Select the next model.\n"
+                << "- F(f): Select the model nearest to my character.\n"
                 << "- W(w) / S(s): Move front / back.\n"
                 << "- A(a) / D(d): Move left / right.\n"
                 << "- Q(q) / E(e): See left / right.\n"
                 << "- O(o) / P(p): See up / down.\n"
-                << "- U(u) / I(i): Increase / Decrease the resolution.\n";
+                << "- U(u) / I(i): Increase / Decrease the resolution.\n"
+                << "- C(c): Capture the screen. (CaptureN.ppm)\n"
+                << "- G(g): Print the number of GL state changes and culled models in the last frame.\n"
+                << "- T(t): Print the frame & pass times of the last frames. (Profile.json, Profile.csv)\n";
+    }
+
+    void printStateCounters() {
+        auto &counters = Engine::GLState::getFrameCounters();
+
+        std::cout
+                << "GL state changes: " << counters.getIssued() << " issued, "
+                << counters.getElided() << " skipped.\n"
+                << "Shadow pass: " << renderQueue.getDrawnCount(Engine::RenderQueue::Pass::SHADOW) << " drawn, "
+                << renderQueue.getCulledCount(Engine::RenderQueue::Pass::SHADOW) << " culled.\n"
+                << "Main pass: " << renderQueue.getDrawnCount(Engine::RenderQueue::Pass::OPAQUE) << " drawn, "
+                << renderQueue.getCulledCount(Engine::RenderQueue::Pass::OPAQUE) << " culled.\n";
+    }
+
+    // Write the pixels into a binary PPM. (Flipped, since GL gives the rows from the bottom.)
+    static void saveCapture(const std::string &path, const Engine::AsyncReadback::Result &result) {
+        std::ofstream file(path, std::ios::binary);
+
+        if (!file) {
+            std::cout << "Failed to save " << path << ".\n";
+            return;
+        }
+
+        file << "P6\n" << result.width << " " << result.height << "\n255\n";
+
+        std::vector<char> row(static_cast<size_t>(result.width) * 3);
+
+        for (auto y = result.height - 1; y >= 0; y--) {
+            auto pixel = &result.data[static_cast<size_t>(y) * result.width * 4];
+
+            for (GLsizei x = 0; x < result.width; x++) {
+                row[x * 3] = static_cast<char>(pixel[x * 4]);
+                row[x * 3 + 1] = static_cast<char>(pixel[x * 4 + 1]);
+                row[x * 3 + 2] = static_cast<char>(pixel[x * 4 + 2]);
+            }
+
+            file.write(row.data(), row.size());
+        }
+
+        std::cout << "Saved " << path << ".\n";
     }
 
     // Since CLion can't detect GLM's operator overloading well, I made this function...
@@ -464,9 +784,92 @@ private:
     }
 };
 
-int main() {
+// Parse the OBJ file single-threaded, and threaded with several thread counts. Prints the counts that give
+// different streams. (OBJParser promises the same streams for any count, whatever the size of the file.)
+static bool checkOBJ(const std::string &path) {
+    std::vector<glm::vec3> positionList;
+    std::vector<glm::vec3> normalList;
+    std::vector<glm::vec2> uvList;
+
+    Engine::OBJParser::parse(path, SINGLE_THREAD, positionList, normalList, uvList);
+
+    auto isSame = true;
+
+    for (auto threadCount : {1, 2, 3, 8, 64, Engine::OBJParser::ALL_THREADS}) {
+        std::vector<glm::vec3> threadedPositionList;
+        std::vector<glm::vec3> threadedNormalList;
+        std::vector<glm::vec2> threadedUVList;
+
+        Engine::OBJParser::parse(path, threadCount, threadedPositionList, threadedNormalList, threadedUVList);
+
+        if (threadedPositionList != positionList || threadedNormalList != normalList || threadedUVList != uvList) {
+            std::cout << path << ": " << threadCount << " threads give " << threadedPositionList.size()
+                      << " vertices, not " << positionList.size() << ".\n";
+            isSame = false;
+        }
+    }
+
+    std::cout << path << ": " << (isSame ? "OK" : "Mismatch") << " (" << positionList.size() << " vertices)\n";
+
+    return isSame;
+}
+
+// Usage:
+// - HW3                    : Open the window. (Synced to the display. The scene is updated on its own thread.)
+// - HW3 --fps N            : Open the window without vsync, and keep the frame rate under N. (0: Uncapped)
+// - HW3 --offscreen [N]    : Render N frames (default: 1000) without a window, print the time per frame,
+//                            save the last frame into Capture0.ppm and the frame times into Profile.json & .csv.
+//                            (For benchmarks & image tests. Each frame advances the scene by 1/60 seconds,
+//                            on the GL thread.)
+// - HW3 --check-obj FILE.. : Check that the threaded OBJ parser gives the same streams as the single-threaded one.
+int main(int argc, char *argv[]) {
     try {
-        MyRenderer().run();
+        if (argc >= 2 && std::string(argv[1]) == "--check-obj") {
+            auto isSame = true;
+
+            for (int i = 2; i < argc; i++) {
+                isSame = checkOBJ(argv[i]) && isSame;
+            }
+
+            return isSame ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+
+        if (argc >= 2 && std::string(argv[1]) == "--offscreen") {
+            auto frameCount = argc >= 3 ? std::max(std::atoi(argv[2]), 1) : 1000;
+            MyRenderer renderer(Engine::Backend::OFFSCREEN);
+
+            // Same scene at any speed, so the captures can be compared.
+            renderer.setFixedFrameTime(1.0 / 60.0);
+            renderer.finishTextures();
+
+            auto startTime = std::chrono::steady_clock::now();
+
+            renderer.renderFrames(frameCount - 1);
+            renderer.capture();
+            renderer.renderFrames(1);
+            renderer.finishCaptures();
+
+            auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+            std::cout << frameCount << " frames, " << seconds * 1000.0 / frameCount << " ms/frame\n";
+            renderer.saveProfile();
+
+            return EXIT_SUCCESS;
+        }
+
+        MyRenderer renderer;
+
+        renderer.setThreadedUpdate(true);
+
+        if (argc >= 3 && std::string(argv[1]) == "--fps") {
+            renderer.setSwapInterval(0);
+            renderer.setFrameLimit(std::atof(argv[2]));
+        }
+        else {
+            renderer.setSwapInterval(1);
+        }
+
+        renderer.run();
 
         return EXIT_SUCCESS;
     }
@@ -1297,7 +1297,8 @@ bool parseObj(attrib_t *attrib, std::vector<shape_t> *shapes,
         auto start_idx = (t + 0) * chunk_size;
         auto end_idx = (std::min)((t + 1) * chunk_size, len - 1);
         if (t == static_cast<size_t>((num_threads - 1))) {
-          end_idx = len - 1;
+          // Scan up to the last byte so that the final line ending is seen.
+          end_idx = len;
         }
 
         size_t prev_pos = start_idx;
@@ -1323,6 +1324,16 @@ bool parseObj(attrib_t *attrib, std::vector<shape_t> *shapes,
           }
         }
 
+        // The last line may have no line ending.
+        if ((t == static_cast<size_t>((num_threads - 1))) && (prev_pos < len) &&
+            ((t == 0) || (prev_pos != start_idx) ||
+             is_line_ending(buf, start_idx - 1, end_idx))) {
+          LineInfo info;
+          info.pos = prev_pos;
+          info.len = len - prev_pos;
+          line_infos[t].push_back(info);
+        }
+
         // Find extra line which spand across chunk boundary.
         if ((t < num_threads) && (buf[end_idx - 1] != '\n')) {
           auto extra_span_idx = (std::min)(end_idx - 1 + chunk_size, len - 1);
@@ -1510,8 +1521,10 @@ bool parseObj(attrib_t *attrib, std::vector<shape_t> *shapes,
     StackVector<std::thread, 16> workers;
 
     for (size_t t = 0; t < num_threads; t++) {
-      int material_id = -1;  // -1 = default unknown material.
       workers->push_back(std::thread([&, t]() {
+        // One per thread. (Captured by reference, it was shared by all the
+        // threads and read after the loop's scope ended.)
+        int material_id = -1;  // -1 = default unknown material.
         size_t v_count = v_offsets[t];
         size_t n_count = n_offsets[t];
         size_t t_count = t_offsets[t];
@@ -1632,7 +1645,8 @@ bool parseObj(attrib_t *attrib, std::vector<shape_t> *shapes,
           }
         }
         if (commands[t][i].type == COMMAND_F) {
-          face_count++;
+          // Count the faces after triangulation, like attrib->face_num_verts does.
+          face_count += commands[t][i].f_num_verts.size();
         }
       }
     }